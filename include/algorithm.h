@@ -1,9 +1,17 @@
 #ifndef ALGORITHM_H_INCLUDED
 #define ALGORITHM_H_INCLUDED
 
+#include "allocator.h"
 #include "iterator_traits.h"
 #include "iterator.h"
 #include "utilities.h"
+#include "function.h"
+#include "type_traits.h"
+#include "searcher.h"
+#include "simd.h"
+
+#include <cstring>  //memmove
+#include <utility>  //std::move
 
 
 #define USE_RECUR 0
@@ -13,8 +21,8 @@ SSTL_NAMESPACE_BEGIN
 //sequence
 //equal
 template <class InputIterator1,class InputIterator2>
-bool equal(InputIterator1 begin1,InputIterator1 end1,
-           InputIterator2 begin2)
+bool equal_dispatch(InputIterator1 begin1,InputIterator1 end1,
+                    InputIterator2 begin2,false_type)
 {
     for(;begin1!=end1;++begin1,++begin2)
         if(*begin1!=*begin2)
@@ -22,6 +30,22 @@ bool equal(InputIterator1 begin1,InputIterator1 end1,
     return true;
 }
 
+//integers of one size,see is_scan_pair:equal values are equal bytes
+template <class T1,class T2>
+bool equal_dispatch(T1* begin1,T1* end1,T2* begin2,true_type)
+{
+    typedef typename scan_unsigned<T1>::type U;
+    return simd_equal(reinterpret_cast<const U*>(begin1),reinterpret_cast<const U*>(begin2),end1-begin1);
+}
+
+template <class InputIterator1,class InputIterator2>
+bool equal(InputIterator1 begin1,InputIterator1 end1,
+           InputIterator2 begin2)
+{
+    return equal_dispatch(begin1,end1,begin2,
+                          typename bool_tag<is_scan_pair<InputIterator1,InputIterator2>::value>::type());
+}
+
 
 //fill
 template <class ForwardIterator,class T>
@@ -51,19 +75,26 @@ void iter_swap(ForwardIterator1 iter1,ForwardIterator2 iter2)
 
 
 //lexicographical_compare
-template <class InputIterator1,class InputIterator2>
+template <class InputIterator1,class InputIterator2,class Compare>
 bool lexicographical_compare(InputIterator1 begin1,InputIterator1 end1,
-                             InputIterator2 begin2,InputIterator2 end2)
+                             InputIterator2 begin2,InputIterator2 end2,Compare comp)
 {
     for(;begin1!=end1 && begin2!=end2;++begin1,++begin2){
-        if(*begin1<*begin2)
+        if(comp(*begin1,*begin2))
             return true;
-        else if(*begin1 >*begin2)
+        else if(comp(*begin2,*begin1))
             return false;
     }
     return begin1==end1 && begin2!=end2;
 }
 
+template <class InputIterator1,class InputIterator2>
+bool lexicographical_compare(InputIterator1 begin1,InputIterator1 end1,
+                             InputIterator2 begin2,InputIterator2 end2)
+{
+    return sstl::lexicographical_compare(begin1,end1,begin2,end2,less<>());
+}
+
 
 //max
 template <class T>
@@ -72,6 +103,12 @@ const T& max(const T& a,const T& b)
     return a < b ? b : a;
 }
 
+template <class T,class Compare>
+const T& max(const T& a,const T& b,Compare comp)
+{
+    return comp(a,b) ? b : a;
+}
+
 
 //min
 template <class T>
@@ -80,17 +117,40 @@ const T& min(const T& a,const T& b)
     return a < b ? a : b;
 }
 
+template <class T,class Compare>
+const T& min(const T& a,const T& b,Compare comp)
+{
+    return comp(b,a) ? b : a;
+}
+
 
 //mismatch
 template <class InputIterator1,class InputIterator2>
 pair<InputIterator1,InputIterator2>
-mismatch(InputIterator1 begin1,InputIterator1 end1,InputIterator2 begin2)
+mismatch_dispatch(InputIterator1 begin1,InputIterator1 end1,InputIterator2 begin2,false_type)
 {
     for(;begin1!=end1 && *begin1==*begin2;++begin1,++begin2)
         ;
     return pair<InputIterator1,InputIterator2>(begin1,begin2);
 }
 
+template <class T1,class T2>
+pair<T1*,T2*> mismatch_dispatch(T1* begin1,T1* end1,T2* begin2,true_type)
+{
+    typedef typename scan_unsigned<T1>::type U;
+    size_t i=simd_mismatch(reinterpret_cast<const U*>(begin1),
+                           reinterpret_cast<const U*>(begin2),end1-begin1);
+    return pair<T1*,T2*>(begin1+i,begin2+i);
+}
+
+template <class InputIterator1,class InputIterator2>
+pair<InputIterator1,InputIterator2>
+mismatch(InputIterator1 begin1,InputIterator1 end1,InputIterator2 begin2)
+{
+    return mismatch_dispatch(begin1,end1,begin2,
+                             typename bool_tag<is_scan_pair<InputIterator1,InputIterator2>::value>::type());
+}
+
 
 //swap
 template <class T>
@@ -100,37 +160,133 @@ void swap(T& a,T& b)
 }
 
 
-//copy--to be perfected
+//copy
+//input iterators:compare against end every step
 template <class InputIterator,class OutputIterator>
-OutputIterator copy(InputIterator begin,InputIterator end,
-                    OutputIterator result)
+OutputIterator copy_dispatch(InputIterator begin,InputIterator end,
+                             OutputIterator result,input_iterator_tag)
 {
     for(;begin!=end;++begin,++result)
         *result=*begin;
     return result;
 }
 
+//random access:a counted loop the compiler can unroll
+template <class RandomAccessIterator,class OutputIterator>
+OutputIterator copy_dispatch(RandomAccessIterator begin,RandomAccessIterator end,
+                             OutputIterator result,random_access_iterator_tag)
+{
+    for(auto n=end-begin;n>0;--n,++begin,++result)
+        *result=*begin;
+    return result;
+}
+
+template <class T>
+T* copy_trivial(const T* begin,const T* end,T* result,true_type)
+{
+    ptrdiff_t n=end-begin;
+    if(n>0)
+        std::memmove(result,begin,sizeof(T)*n);
+    return result+n;
+}
+
+template <class T>
+T* copy_trivial(const T* begin,const T* end,T* result,false_type)
+{
+    for(ptrdiff_t n=end-begin;n>0;--n,++begin,++result)
+        *result=*begin;
+    return result;
+}
+
+//pointers to trivially copyable types:memmove(the ranges may overlap)
+template <class T>
+T* copy_dispatch(const T* begin,const T* end,T* result,random_access_iterator_tag)
+{
+    return copy_trivial(begin,end,result,typename bool_tag<is_trivially_copyable<T>::value>::type());
+}
+
+template <class T>
+T* copy_dispatch(T* begin,T* end,T* result,random_access_iterator_tag)
+{
+    return copy_trivial<T>(begin,end,result,typename bool_tag<is_trivially_copyable<T>::value>::type());
+}
+
+template <class InputIterator,class OutputIterator>
+OutputIterator copy(InputIterator begin,InputIterator end,
+                    OutputIterator result)
+{
+    typedef typename iterator_traits<InputIterator>::iterator_category category;
+    return copy_dispatch(begin,end,result,category());
+}
+
+
+//copy_backward
+//result is the end of the destination,returns its begin
+template <class BidirectionalIterator1,class BidirectionalIterator2>
+BidirectionalIterator2 copy_backward_dispatch(BidirectionalIterator1 begin,
+                                              BidirectionalIterator1 end,
+                                              BidirectionalIterator2 result,
+                                              bidirectional_iterator_tag)
+{
+    while(begin!=end)
+        *--result=*--end;
+    return result;
+}
+
+template <class RandomAccessIterator,class BidirectionalIterator>
+BidirectionalIterator copy_backward_dispatch(RandomAccessIterator begin,
+                                             RandomAccessIterator end,
+                                             BidirectionalIterator result,
+                                             random_access_iterator_tag)
+{
+    for(auto n=end-begin;n>0;--n)
+        *--result=*--end;
+    return result;
+}
+
+template <class T>
+T* copy_backward_trivial(const T* begin,const T* end,T* result,true_type)
+{
+    ptrdiff_t n=end-begin;
+    if(n>0)
+        std::memmove(result-n,begin,sizeof(T)*n);
+    return result-n;
+}
+
+template <class T>
+T* copy_backward_trivial(const T* begin,const T* end,T* result,false_type)
+{
+    for(ptrdiff_t n=end-begin;n>0;--n)
+        *--result=*--end;
+    return result;
+}
+
+template <class T>
+T* copy_backward_dispatch(const T* begin,const T* end,T* result,random_access_iterator_tag)
+{
+    return copy_backward_trivial(begin,end,result,typename bool_tag<is_trivially_copyable<T>::value>::type());
+}
+
+template <class T>
+T* copy_backward_dispatch(T* begin,T* end,T* result,random_access_iterator_tag)
+{
+    return copy_backward_trivial<T>(begin,end,result,typename bool_tag<is_trivially_copyable<T>::value>::type());
+}
 
-//copy_backward--to be perfected
 template <class BidirectionalIterator1,class BidirectionalIterator2>
 BidirectionalIterator2 copy_backward(BidirectionalIterator1 begin,
                                      BidirectionalIterator1 end,
                                      BidirectionalIterator2 result)
 {
-    auto rbegin=reverse_iterator<BidirectionalIterator1>(end);
-    auto rend=reverse_iterator<BidirectionalIterator1>(begin);
-
-    for(;rbegin!=rend;++rbegin,--result)
-        *result=*rbegin;
-
-    return result;
+    typedef typename iterator_traits<BidirectionalIterator1>::iterator_category category;
+    return copy_backward_dispatch(begin,end,result,category());
 }
 
 
 //other
 //adjacent_find
 template <class ForwardIterator>
-ForwardIterator adjacent_find(ForwardIterator begin,ForwardIterator end)
+ForwardIterator adjacent_find_dispatch(ForwardIterator begin,ForwardIterator end,false_type)
 {
     if(begin==end) return end;
     auto pre=begin++;
@@ -141,11 +297,26 @@ ForwardIterator adjacent_find(ForwardIterator begin,ForwardIterator end)
     return end;
 }
 
+template <class T>
+T* adjacent_find_dispatch(T* begin,T* end,true_type)
+{
+    typedef typename scan_unsigned<T>::type U;
+    size_t n=end-begin;
+    size_t i=simd_adjacent_find(reinterpret_cast<const U*>(begin),n);
+    return i==n ? end : begin+i;
+}
+
+template <class ForwardIterator>
+ForwardIterator adjacent_find(ForwardIterator begin,ForwardIterator end)
+{
+    return adjacent_find_dispatch(begin,end,typename bool_tag<is_scan_pointer<ForwardIterator>::value>::type());
+}
+
 
 //count
 template <class InputIterator,class T>
 typename iterator_traits<InputIterator>::difference_type
-count(InputIterator begin,InputIterator end,const T& value)
+count_dispatch(InputIterator begin,InputIterator end,const T& value,false_type)
 {
     typename iterator_traits<InputIterator>::difference_type n=0;
     while(begin!=end)
@@ -154,29 +325,61 @@ count(InputIterator begin,InputIterator end,const T& value)
     return n;
 }
 
+template <class T,class V>
+ptrdiff_t count_dispatch(T* begin,T* end,const V& value,true_type)
+{
+    typedef typename scan_unsigned<T>::type U;
+    typename std::remove_cv<T>::type v=static_cast<T>(value);
+    if(v!=value) return 0;  //value is out of T's range,no element can equal it
+    return simd_count(reinterpret_cast<const U*>(begin),end-begin,static_cast<U>(v));
+}
+
+template <class InputIterator,class T>
+typename iterator_traits<InputIterator>::difference_type
+count(InputIterator begin,InputIterator end,const T& value)
+{
+    return count_dispatch(begin,end,value,typename bool_tag<is_scan_value<InputIterator,T>::value>::type());
+}
+
 
 //count_if
+//the predicate is opaque to the kernels;adding its result instead of branching on it
+//leaves the compiler a loop it can vectorize once pred is inlined
 template <class InputIterator,class Predicate>
 typename iterator_traits<InputIterator>::difference_type
 count_if(InputIterator begin,InputIterator end,Predicate pred)
 {
     typename iterator_traits<InputIterator>::difference_type n=0;
-    while(begin!=end)
-        if(pred(*begin++))
-            ++n;
+    for(;begin!=end;++begin)
+        n+=pred(*begin) ? 1 : 0;
     return n;
 }
 
 
 //find
 template <class InputIterator,class T>
-InputIterator find(InputIterator begin,InputIterator end,const T& value)
+InputIterator find_dispatch(InputIterator begin,InputIterator end,const T& value,false_type)
 {
     while(begin!=end && *begin!=value)
         ++begin;
     return begin;
 }
 
+template <class T,class V>
+T* find_dispatch(T* begin,T* end,const V& value,true_type)
+{
+    typedef typename scan_unsigned<T>::type U;
+    typename std::remove_cv<T>::type v=static_cast<T>(value);
+    if(v!=value) return end;
+    return begin+simd_find(reinterpret_cast<const U*>(begin),end-begin,static_cast<U>(v));
+}
+
+template <class InputIterator,class T>
+InputIterator find(InputIterator begin,InputIterator end,const T& value)
+{
+    return find_dispatch(begin,end,value,typename bool_tag<is_scan_value<InputIterator,T>::value>::type());
+}
+
 
 //find_if
 template <class InputIterator,class Predicate>
@@ -188,15 +391,6 @@ InputIterator find_if(InputIterator begin,InputIterator end,Predicate pred)
 }
 
 
-//find_end--to do
-template <class ForwardIterator1,class ForwardIterator2>
-ForwardIterator1 find_end(ForwardIterator1 begin1,ForwardIterator1 end1,
-                          ForwardIterator2 begin2,ForwardIterator2 end2)
-{
-
-}
-
-
 //find_first_of
 template <class InputIterator,class ForwardIterator>
 InputIterator find_first_of(InputIterator begin1,InputIterator end1,
@@ -240,61 +434,202 @@ OutputIterator generate_n(OutputIterator begin,Size n,Generator gen)
 
 
 //includes
-template <class InputIterator1,class InputIterator2>
+template <class InputIterator1,class InputIterator2,class Compare>
 bool includes(InputIterator1 begin1,InputIterator1 end1,
-              InputIterator2 begin2,InputIterator2 end2)
+              InputIterator2 begin2,InputIterator2 end2,Compare comp)
 {
     while(begin1!=end1 && begin2!=end2)
-        if(*begin1>*begin2)
+        if(comp(*begin2,*begin1))
             return false;
-        else if(*begin1<*begin2)
+        else if(comp(*begin1,*begin2))
             ++begin1;
         else
             ++begin1,++begin2;
     return begin2==end2;
 }
 
+template <class InputIterator1,class InputIterator2>
+bool includes(InputIterator1 begin1,InputIterator1 end1,
+              InputIterator2 begin2,InputIterator2 end2)
+{
+    return sstl::includes(begin1,end1,begin2,end2,less<>());
+}
+
 
 //max_element
-template <class ForwardIterator>
-ForwardIterator max_element(ForwardIterator begin,ForwardIterator end)
+template <class ForwardIterator,class Compare>
+ForwardIterator max_element(ForwardIterator begin,ForwardIterator end,Compare comp)
 {
     if(begin==end) return end;
     auto result=begin;
     while(++begin!=end)
-        if(*begin>*result)
+        if(comp(*result,*begin))
             result=begin;
     return result;
 }
 
+template <class ForwardIterator>
+ForwardIterator max_element_dispatch(ForwardIterator begin,ForwardIterator end,false_type)
+{
+    return sstl::max_element(begin,end,less<>());
+}
+
+//a NaN first element is the result,nothing compares greater than it
+template <class T>
+T* max_element_dispatch(T* begin,T* end,true_type)
+{
+    if(begin==end || *begin!=*begin) return begin;
+    return begin+simd_max_element(const_cast<const typename std::remove_cv<T>::type*>(begin),end-begin);
+}
 
-//min_element
 template <class ForwardIterator>
-ForwardIterator min_element(ForwardIterator begin,ForwardIterator end)
+ForwardIterator max_element(ForwardIterator begin,ForwardIterator end)
+{
+    return max_element_dispatch(begin,end,typename bool_tag<is_minmax_pointer<ForwardIterator>::value>::type());
+}
+
+
+//min_element
+template <class ForwardIterator,class Compare>
+ForwardIterator min_element(ForwardIterator begin,ForwardIterator end,Compare comp)
 {
     if(begin==end) return end;
     auto result=begin;
     while(++begin!=end)
-        if(*begin<*result)
+        if(comp(*begin,*result))
             result=begin;
     return result;
 }
 
+template <class ForwardIterator>
+ForwardIterator min_element_dispatch(ForwardIterator begin,ForwardIterator end,false_type)
+{
+    return sstl::min_element(begin,end,less<>());
+}
+
+template <class T>
+T* min_element_dispatch(T* begin,T* end,true_type)
+{
+    if(begin==end || *begin!=*begin) return begin;
+    return begin+simd_min_element(const_cast<const typename std::remove_cv<T>::type*>(begin),end-begin);
+}
+
+template <class ForwardIterator>
+ForwardIterator min_element(ForwardIterator begin,ForwardIterator end)
+{
+    return min_element_dispatch(begin,end,typename bool_tag<is_minmax_pointer<ForwardIterator>::value>::type());
+}
+
+
+//minmax_element
+//the first smallest and the last largest in one pass.elements are taken in pairs:
+//the smaller of a pair can only be the minimum,the larger only the maximum,so a
+//pair costs 3 comparisons instead of 4.
+template <class ForwardIterator,class Compare>
+pair<ForwardIterator,ForwardIterator>
+minmax_element(ForwardIterator begin,ForwardIterator end,Compare comp)
+{
+    pair<ForwardIterator,ForwardIterator> result(begin,begin);
+    if(begin==end || ++begin==end) return result;
+    if(comp(*begin,*result.first))
+        result.first=begin;
+    else
+        result.second=begin;
+
+    while(++begin!=end){
+        auto first=begin;
+        if(++begin==end){
+            if(comp(*first,*result.first))
+                result.first=first;
+            else if(!comp(*first,*result.second))
+                result.second=first;
+            break;
+        }
+        if(comp(*begin,*first)){
+            if(comp(*begin,*result.first))
+                result.first=begin;
+            if(!comp(*first,*result.second))
+                result.second=first;
+        }else{
+            if(comp(*first,*result.first))
+                result.first=first;
+            if(!comp(*begin,*result.second))
+                result.second=begin;
+        }
+    }
+    return result;
+}
+
+template <class ForwardIterator>
+pair<ForwardIterator,ForwardIterator>
+minmax_element_dispatch(ForwardIterator begin,ForwardIterator end,false_type)
+{
+    return sstl::minmax_element(begin,end,less<>());
+}
+
+//a NaN breaks the ordering the pairs rely on,the generic loop handles a NaN first element
+template <class T>
+pair<T*,T*> minmax_element_dispatch(T* begin,T* end,true_type)
+{
+    if(begin==end || *begin!=*begin)
+        return sstl::minmax_element(begin,end,less<>());
+    size_t min,max;
+    simd_minmax_element(const_cast<const typename std::remove_cv<T>::type*>(begin),end-begin,min,max);
+    return pair<T*,T*>(begin+min,begin+max);
+}
+
+template <class ForwardIterator>
+pair<ForwardIterator,ForwardIterator>
+minmax_element(ForwardIterator begin,ForwardIterator end)
+{
+    return minmax_element_dispatch(begin,end,typename bool_tag<is_minmax_pointer<ForwardIterator>::value>::type());
+}
+
 
 //merge
-template <class InputIterator1,class InputIterator2,class OutputIterator>
+//stable:on ties the element of the first range goes first
+template <class InputIterator1,class InputIterator2,class OutputIterator,class Compare>
 OutputIterator merge(InputIterator1 begin1,InputIterator1 end1,
                      InputIterator2 begin2,InputIterator2 end2,
-                     OutputIterator result)
+                     OutputIterator result,Compare comp)
 {
     while(begin1!=end1 && begin2!=end2)
 
-        if(*begin1<*begin2)
-            *result++=*begin1++;
-        else
+        if(comp(*begin2,*begin1))
             *result++=*begin2++;
+        else
+            *result++=*begin1++;
+
+    return sstl::copy(begin2,end2,sstl::copy(begin1,end1,result));
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator>
+OutputIterator merge(InputIterator1 begin1,InputIterator1 end1,
+                     InputIterator2 begin2,InputIterator2 end2,
+                     OutputIterator result)
+{
+    return sstl::merge(begin1,end1,begin2,end2,result,less<>());
+}
 
-    return copy(begin1,end1,copy(begin2,end2,result));
+//move_merge
+//merge moving the elements instead of copying them,the sources are left moved-from
+template <class InputIterator1,class InputIterator2,class OutputIterator,class Compare>
+OutputIterator move_merge(InputIterator1 begin1,InputIterator1 end1,
+                          InputIterator2 begin2,InputIterator2 end2,
+                          OutputIterator result,Compare comp)
+{
+    while(begin1!=end1 && begin2!=end2){
+        if(comp(*begin2,*begin1))
+            *result=std::move(*begin2++);
+        else
+            *result=std::move(*begin1++);
+        ++result;
+    }
+    for(;begin1!=end1;++begin1,++result)
+        *result=std::move(*begin1);
+    for(;begin2!=end2;++begin2,++result)
+        *result=std::move(*begin2);
+    return result;
 }
 
 
@@ -421,7 +756,7 @@ template <class BidirectionalIterator>
 void reverse(BidirectionalIterator begin,BidirectionalIterator end)
 {
     while(begin!=end && begin!=--end)
-        iter_swap(begin++,end);
+        sstl::iter_swap(begin++,end);
 }
 
 
@@ -437,14 +772,14 @@ OutputIterator reverse_copy(BidirectionalIterator begin,
 }
 
 
-//rotate--to be perfected
+//rotate
+//forward iterators:swap the front block into place,then continue with what is left
 template <class ForwardIterator>
-void rotate(ForwardIterator begin,ForwardIterator middle,ForwardIterator end)
+void rotate_dispatch(ForwardIterator begin,ForwardIterator middle,ForwardIterator end,forward_iterator_tag)
 {
-    if(begin==middle || end==middle) return;
     auto iter=middle;
     while(true){
-        iter_swap(begin++,iter++);
+        sstl::iter_swap(begin++,iter++);
         if(begin==middle && iter==end)
             return;
         else if(begin==middle)
@@ -454,41 +789,271 @@ void rotate(ForwardIterator begin,ForwardIterator middle,ForwardIterator end)
     }
 }
 
-
-//rotate_copy
-template <class ForwardIterator,class OutputIterator>
-OutputIterator rotate_copy(ForwardIterator begin,ForwardIterator middle,
-                           ForwardIterator end,OutputIterator result)
+//bidirectional iterators:three reversals
+template <class BidirectionalIterator>
+void rotate_dispatch(BidirectionalIterator begin,BidirectionalIterator middle,BidirectionalIterator end,
+                     bidirectional_iterator_tag)
 {
-    return copy(begin,middle,copy(middle,end,result));
+    sstl::reverse(begin,middle);
+    sstl::reverse(middle,end);
+    sstl::reverse(begin,end);
 }
 
-
-//search
-template <class ForwardIterator1,class ForwardIterator2>
-ForwardIterator1 search(ForwardIterator1 begin1,ForwardIterator1 end1,
-                        ForwardIterator2 begin2,ForwardIterator2 end2)
+template <class Distance>
+Distance rotate_gcd(Distance m,Distance n)
 {
+    while(n!=0){
+        Distance t=m%n;
+        m=n;
+        n=t;
+    }
+    return m;
+}
 
-    auto d1=distance(begin1,end1);
-    auto d2=distance(begin2,end2);
-
-    if(d1<d2) return end1;
-    auto iter1=begin1;
-    auto iter2=begin2;
-    while(iter2!=end2){
-        if(*iter1==*iter2)
-            ++iter1,++iter2;
-        else
-            if(d1==d2)
-                return end1;
-            else{
-                iter1=++begin1;
-                iter2=begin2;
-                --d1;
-            }
+//random access:gcd(n,k) cycles,every element is moved exactly once
+template <class RandomAccessIterator>
+void rotate_cycle(RandomAccessIterator begin,RandomAccessIterator middle,RandomAccessIterator end)
+{
+    auto n=end-begin;
+    auto k=middle-begin;
+    for(auto cycles=rotate_gcd(n,k);cycles>0;--cycles){
+        RandomAccessIterator start=begin+(cycles-1);
+        auto value=std::move(*start);
+        RandomAccessIterator hole=start;
+        RandomAccessIterator next=hole+k;
+        while(next!=start){
+            *hole=std::move(*next);
+            hole=next;
+            next= end-next>k ? next+k : begin+(k-(end-next));
+        }
+        *hole=std::move(value);
     }
-    return begin1;
+}
+
+template <class RandomAccessIterator>
+void rotate_dispatch(RandomAccessIterator begin,RandomAccessIterator middle,RandomAccessIterator end,
+                     random_access_iterator_tag)
+{
+    rotate_cycle(begin,middle,end);
+}
+
+//block swap(Gries-Mills):swap the shorter side with its mirror block at the far
+//end,which leaves a smaller rotation of the same kind.every pass is a plain
+//sequential loop,far kinder to the cache than the cycles' strides on big ranges.
+template <class T>
+void rotate_block_swap(T* begin,T* middle,T* end)
+{
+    while(begin!=middle && middle!=end){
+        ptrdiff_t left=middle-begin;
+        ptrdiff_t right=end-middle;
+        if(left<=right){
+            //[begin,middle) swapped with the block right after it
+            for(T* p=begin;p!=middle;++p)
+                sstl::iter_swap(p,p+left);
+            begin=middle;
+            middle+=left;
+        }else{
+            //[middle,end) swapped with the block right before it
+            for(T *p=middle-right,*q=middle;q!=end;++p,++q)
+                sstl::iter_swap(p,q);
+            end=middle;
+            middle-=right;
+        }
+    }
+}
+
+//bytes of the stack buffer for short trivial rotations
+constexpr size_t rotate_buffer_size=256;
+
+//trivially copyable:when the shorter side fits the buffer,park it there and
+//memmove the longer side over,otherwise swap blocks(swaps of trivial types
+//vectorize,the cycles' single moves do not)
+template <class T>
+void rotate_trivial(T* begin,T* middle,T* end,true_type)
+{
+    ptrdiff_t left=middle-begin;
+    ptrdiff_t right=end-middle;
+    if(sstl::min(left,right)*sizeof(T)>rotate_buffer_size){
+        rotate_block_swap(begin,middle,end);
+        return;
+    }
+
+    alignas(T) unsigned char buffer[rotate_buffer_size];
+    if(left<=right){
+        std::memcpy(buffer,begin,left*sizeof(T));
+        std::memmove(begin,middle,right*sizeof(T));
+        std::memcpy(begin+right,buffer,left*sizeof(T));
+    }else{
+        std::memcpy(buffer,middle,right*sizeof(T));
+        std::memmove(begin+right,begin,left*sizeof(T));
+        std::memcpy(begin,buffer,right*sizeof(T));
+    }
+}
+
+template <class T>
+void rotate_trivial(T* begin,T* middle,T* end,false_type)
+{
+    rotate_cycle(begin,middle,end);
+}
+
+template <class T>
+void rotate_dispatch(T* begin,T* middle,T* end,random_access_iterator_tag)
+{
+    rotate_trivial(begin,middle,end,typename bool_tag<is_trivially_copyable<T>::value>::type());
+}
+
+template <class ForwardIterator>
+void rotate(ForwardIterator begin,ForwardIterator middle,ForwardIterator end)
+{
+    if(begin==middle || end==middle) return;
+    typedef typename iterator_traits<ForwardIterator>::iterator_category category;
+    rotate_dispatch(begin,middle,end,category());
+}
+
+
+//rotate_copy
+template <class ForwardIterator,class OutputIterator>
+OutputIterator rotate_copy(ForwardIterator begin,ForwardIterator middle,
+                           ForwardIterator end,OutputIterator result)
+{
+    return copy(begin,middle,copy(middle,end,result));
+}
+
+
+//search
+//naive:on a mismatch restart one past the last start,O(n*m)
+template <class ForwardIterator1,class ForwardIterator2>
+ForwardIterator1 search_naive(ForwardIterator1 begin1,ForwardIterator1 end1,
+                              ForwardIterator2 begin2,ForwardIterator2 end2)
+{
+
+    auto d1=sstl::distance(begin1,end1);
+    auto d2=sstl::distance(begin2,end2);
+
+    if(d1<d2) return end1;
+    auto iter1=begin1;
+    auto iter2=begin2;
+    while(iter2!=end2){
+        if(*iter1==*iter2)
+            ++iter1,++iter2;
+        else
+            if(d1==d2)
+                return end1;
+            else{
+                iter1=++begin1;
+                iter2=begin2;
+                --d1;
+            }
+    }
+    return begin1;
+}
+
+template <class ForwardIterator1,class ForwardIterator2>
+ForwardIterator1 search_dispatch(ForwardIterator1 begin1,ForwardIterator1 end1,
+                                 ForwardIterator2 begin2,ForwardIterator2 end2,
+                                 forward_iterator_tag,forward_iterator_tag)
+{
+    return search_naive(begin1,end1,begin2,end2);
+}
+
+//patterns up to this long go to Horspool,longer ones to Two-Way:Horspool is
+//sublinear on average but O(n*m) on repetitive input,Two-Way is always O(n+m)
+constexpr ptrdiff_t horspool_max_pattern=64;
+
+//integral elements:Horspool or Two-Way
+template <class RandomAccessIterator1,class RandomAccessIterator2>
+RandomAccessIterator1 search_random(RandomAccessIterator1 begin1,RandomAccessIterator1 end1,
+                                    RandomAccessIterator2 begin2,RandomAccessIterator2 end2,true_type)
+{
+    if(end2-begin2<=horspool_max_pattern)
+        return horspool_searcher<RandomAccessIterator2>(begin2,end2)(begin1,end1).first;
+    return two_way_searcher<RandomAccessIterator2>(begin2,end2)(begin1,end1).first;
+}
+
+//other types only promise operator==
+template <class RandomAccessIterator1,class RandomAccessIterator2>
+RandomAccessIterator1 search_random(RandomAccessIterator1 begin1,RandomAccessIterator1 end1,
+                                    RandomAccessIterator2 begin2,RandomAccessIterator2 end2,false_type)
+{
+    return search_naive(begin1,end1,begin2,end2);
+}
+
+template <class RandomAccessIterator1,class RandomAccessIterator2>
+RandomAccessIterator1 search_dispatch(RandomAccessIterator1 begin1,RandomAccessIterator1 end1,
+                                      RandomAccessIterator2 begin2,RandomAccessIterator2 end2,
+                                      random_access_iterator_tag,random_access_iterator_tag)
+{
+    //a single element or a text shorter than the pattern is not worth a preprocessing pass
+    if(end2-begin2<2 || end1-begin1<end2-begin2)
+        return search_naive(begin1,end1,begin2,end2);
+
+    typedef typename iterator_traits<RandomAccessIterator1>::value_type T1;
+    typedef typename iterator_traits<RandomAccessIterator2>::value_type T2;
+    return search_random(begin1,end1,begin2,end2,
+                         typename bool_tag<std::is_integral<T1>::value && std::is_integral<T2>::value>::type());
+}
+
+template <class ForwardIterator1,class ForwardIterator2>
+ForwardIterator1 search(ForwardIterator1 begin1,ForwardIterator1 end1,
+                        ForwardIterator2 begin2,ForwardIterator2 end2)
+{
+    typedef typename iterator_traits<ForwardIterator1>::iterator_category category1;
+    typedef typename iterator_traits<ForwardIterator2>::iterator_category category2;
+    return search_dispatch(begin1,end1,begin2,end2,category1(),category2());
+}
+
+//with a prebuilt searcher(searcher.h),to look for one pattern in many ranges
+template <class ForwardIterator,class Searcher>
+ForwardIterator search(ForwardIterator begin,ForwardIterator end,const Searcher& searcher)
+{
+    return searcher(begin,end).first;
+}
+
+
+//find_end
+//the last match of [begin2,end2) in [begin1,end1),end1 if none
+template <class ForwardIterator1,class ForwardIterator2>
+ForwardIterator1 find_end_dispatch(ForwardIterator1 begin1,ForwardIterator1 end1,
+                                   ForwardIterator2 begin2,ForwardIterator2 end2,
+                                   forward_iterator_tag,forward_iterator_tag)
+{
+    if(begin2==end2) return end1;
+
+    ForwardIterator1 result=end1;
+    while(true){
+        ForwardIterator1 iter=sstl::search(begin1,end1,begin2,end2);
+        if(iter==end1)
+            return result;
+        result=begin1=iter;
+        ++begin1;
+    }
+}
+
+//bidirectional:the first match of the reversed pattern in the reversed range
+template <class BidirectionalIterator1,class BidirectionalIterator2>
+BidirectionalIterator1 find_end_dispatch(BidirectionalIterator1 begin1,BidirectionalIterator1 end1,
+                                         BidirectionalIterator2 begin2,BidirectionalIterator2 end2,
+                                         bidirectional_iterator_tag,bidirectional_iterator_tag)
+{
+    if(begin2==end2) return end1;
+
+    typedef sstl::reverse_iterator<BidirectionalIterator1> reverse_iterator1;
+    typedef sstl::reverse_iterator<BidirectionalIterator2> reverse_iterator2;
+
+    reverse_iterator1 rend1(begin1);
+    reverse_iterator1 rresult=sstl::search(reverse_iterator1(end1),rend1,
+                                           reverse_iterator2(end2),reverse_iterator2(begin2));
+    if(rresult==rend1) return end1;
+    return sstl::advance(rresult.base(),-sstl::distance(begin2,end2));
+}
+
+template <class ForwardIterator1,class ForwardIterator2>
+ForwardIterator1 find_end(ForwardIterator1 begin1,ForwardIterator1 end1,
+                          ForwardIterator2 begin2,ForwardIterator2 end2)
+{
+    typedef typename iterator_traits<ForwardIterator1>::iterator_category category1;
+    typedef typename iterator_traits<ForwardIterator2>::iterator_category category2;
+    return find_end_dispatch(begin1,end1,begin2,end2,category1(),category2());
 }
 
 
@@ -559,6 +1124,7 @@ OutputIterator transform(InputIterator1 begin1,InputIterator1 end1,
 {
     for(;begin1!=end1;++begin1,++begin2,++result)
         *result=binary_op(*begin1,*begin2);
+    return result;
 }
 
 
@@ -586,12 +1152,12 @@ ForwardIterator unique(ForwardIterator begin,ForwardIterator end)
 template <class ForwardIterator,class T>
 ForwardIterator lower_bound(ForwardIterator begin,ForwardIterator end,const T& value)
 {
-    auto len=distance(begin,end);
+    auto len=sstl::distance(begin,end);
     decltype(len) half;
     decltype(begin) middle;
     while(len>0){
         half=len >> 1;
-        middle=advance(begin,half);
+        middle=sstl::advance(begin,half);
         if(*middle<value){
             begin=middle;
             ++begin;
@@ -605,16 +1171,37 @@ ForwardIterator lower_bound(ForwardIterator begin,ForwardIterator end,const T& v
 }
 
 
+template <class ForwardIterator,class T,class Compare>
+ForwardIterator lower_bound(ForwardIterator begin,ForwardIterator end,const T& value,Compare comp)
+{
+    auto len=sstl::distance(begin,end);
+    decltype(len) half;
+    decltype(begin) middle;
+    while(len>0){
+        half=len >> 1;
+        middle=sstl::advance(begin,half);
+        if(comp(*middle,value)){
+            begin=middle;
+            ++begin;
+            len=len-half-1;
+        }else{
+            len=half;
+        }
+    }
+    return begin;
+}
+
+
 //upper_bound
 template <class ForwardIterator,class T>
 ForwardIterator upper_bound(ForwardIterator begin,ForwardIterator end,const T& value)
 {
-    auto len=distance(begin,end);
+    auto len=sstl::distance(begin,end);
     decltype(len) half;
     decltype(begin) middle;
     while(len>0){
         half=len >> 1;
-        middle=advance(begin,half);
+        middle=sstl::advance(begin,half);
         if(*middle>value){
             end=middle;     //can be deleted
             len=half;
@@ -628,17 +1215,63 @@ ForwardIterator upper_bound(ForwardIterator begin,ForwardIterator end,const T& v
 }
 
 
+template <class ForwardIterator,class T,class Compare>
+ForwardIterator upper_bound(ForwardIterator begin,ForwardIterator end,const T& value,Compare comp)
+{
+    auto len=sstl::distance(begin,end);
+    decltype(len) half;
+    decltype(begin) middle;
+    while(len>0){
+        half=len >> 1;
+        middle=sstl::advance(begin,half);
+        if(comp(value,*middle)){
+            len=half;
+        }else{
+            begin=middle;
+            ++begin;
+            len=len-half-1;
+        }
+    }
+    return begin;
+}
+
+
 //equal_range
+template <class ForwardIterator,class T,class Compare>
+pair<ForwardIterator,ForwardIterator>
+equal_range(ForwardIterator begin,ForwardIterator end,const T& value,Compare comp)
+{
+    auto len=sstl::distance(begin,end);
+    decltype(len) half;
+    decltype(begin) middle,left,right;
+    while(len>0){
+        half=len >> 1;
+        middle=sstl::advance(begin,half);
+        if(comp(*middle,value)){
+            begin=middle;
+            ++begin;
+            len=len-half-1;
+        }else if(comp(value,*middle)){
+            len=half;
+        }else{
+           left=sstl::lower_bound(begin,middle,value,comp);
+           right=sstl::upper_bound(++middle,sstl::advance(begin,len),value,comp);
+           return {left,right};
+        }
+    }
+    return {begin,begin};
+}
+
 template <class ForwardIterator,class T>
 pair<ForwardIterator,ForwardIterator>
 equal_range(ForwardIterator begin,ForwardIterator end,const T& value)
 {
-    auto len=distance(begin,end);
+    auto len=sstl::distance(begin,end);
     decltype(len) half;
     decltype(begin) middle,left,right;
     while(len>0){
         half=len >> 1;
-        middle=advance(begin,half);
+        middle=sstl::advance(begin,half);
         if(*middle<value){
             begin=middle;
             ++begin;
@@ -647,7 +1280,7 @@ equal_range(ForwardIterator begin,ForwardIterator end,const T& value)
             len=half;
         }else{
            left=lower_bound(begin,middle,value);
-           right=upper_bound(++middle,advance(begin,len),value);
+           right=upper_bound(++middle,sstl::advance(begin,len),value);
            return {left,right};
         }
     }
@@ -663,10 +1296,18 @@ bool binary_search(ForwardIterator begin,ForwardIterator end,const T& value)
     return iter!=end && *iter==value;   //
 }
 
+//equivalence,not ==:value is found if neither is ordered before the other
+template <class ForwardIterator,class T,class Compare>
+bool binary_search(ForwardIterator begin,ForwardIterator end,const T& value,Compare comp)
+{
+    auto iter=sstl::lower_bound(begin,end,value,comp);
+    return iter!=end && !comp(value,*iter);
+}
+
 
 //next_permutation
-template <class BidirectionalIterator>
-bool next_permutation(BidirectionalIterator begin,BidirectionalIterator end)
+template <class BidirectionalIterator,class Compare>
+bool next_permutation(BidirectionalIterator begin,BidirectionalIterator end,Compare comp)
 {
     if(begin==end) return false;
     auto iter=end;
@@ -674,24 +1315,30 @@ bool next_permutation(BidirectionalIterator begin,BidirectionalIterator end)
     decltype(begin) iter_next;
     while(true){
         iter_next=iter--;
-        if(*iter<*iter_next){
+        if(comp(*iter,*iter_next)){
             auto i=end;
-            while(*--i<*iter);  //
-            iter_swap(iter,i);
-            reverse(iter_next,end);
+            while(!comp(*iter,*--i));
+            sstl::iter_swap(iter,i);
+            sstl::reverse(iter_next,end);
             return true;
         }
         if(iter==begin){
-            reverse(begin,end);
+            sstl::reverse(begin,end);
             return false;
         }
     }
 }
 
+template <class BidirectionalIterator>
+bool next_permutation(BidirectionalIterator begin,BidirectionalIterator end)
+{
+    return sstl::next_permutation(begin,end,less<>());
+}
+
 
 //prev_permutation
-template <class BidirectionalIterator>
-bool prev_permutation(BidirectionalIterator begin,BidirectionalIterator end)
+template <class BidirectionalIterator,class Compare>
+bool prev_permutation(BidirectionalIterator begin,BidirectionalIterator end,Compare comp)
 {
     if(begin==end) return false;
     auto iter=end;
@@ -699,20 +1346,26 @@ bool prev_permutation(BidirectionalIterator begin,BidirectionalIterator end)
     decltype(begin) iter_next;
     while(true){
         iter_next=iter--;
-        if(*iter_next<*iter){
+        if(comp(*iter_next,*iter)){
             auto i=end;
-            while(*iter<*--i);  //
-            iter_swap(iter,i);
-            reverse(iter_next,end);
+            while(!comp(*--i,*iter));
+            sstl::iter_swap(iter,i);
+            sstl::reverse(iter_next,end);
             return true;
         }
         if(iter==begin){
-            reverse(begin,end);
+            sstl::reverse(begin,end);
             return false;
         }
     }
 }
 
+template <class BidirectionalIterator>
+bool prev_permutation(BidirectionalIterator begin,BidirectionalIterator end)
+{
+    return sstl::prev_permutation(begin,end,less<>());
+}
+
 
 //random_shuffle
 template <class RandomAccessIterator>
@@ -725,196 +1378,767 @@ void random_shuffle(RandomAccessIterator begin,RandomAccessIterator end)
 
 //sort
 //insertion_sort
-template <class RandomAccessIterator>
-void insertion_sort(RandomAccessIterator begin,
-                    RandomAccessIterator end)
+//move *last left until nothing before it is greater,
+//something before it must not be greater(unguarded).
+template <class RandomAccessIterator,class Compare>
+void unguarded_linear_insert(RandomAccessIterator last,Compare comp)
+{
+    auto value=std::move(*last);
+    RandomAccessIterator next=last;
+    --next;
+    while(comp(value,*next)){
+        *last=std::move(*next);
+        last=next;
+        --next;
+    }
+    *last=std::move(value);
+}
+
+template <class RandomAccessIterator,class Compare>
+void insertion_sort(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
 {
     if(begin==end) return;
 
-    for(auto i=begin+1;i!=end;++i){
-        for(auto j=begin;j!=i;++j){
-            if(*j>*i){
-                auto value=*i;
-                copy_backward(j,i,i);
-                *j=value;
-            }
-        }
+    for(RandomAccessIterator i=begin+1;i!=end;++i){
+        if(comp(*i,*begin)){
+            //new minimum:shift the whole prefix
+            auto value=std::move(*i);
+            for(RandomAccessIterator j=i;j!=begin;--j)
+                *j=std::move(*(j-1));
+            *begin=std::move(value);
+        }else
+            unguarded_linear_insert(i,comp);
     }
 }
 
+template <class RandomAccessIterator>
+void insertion_sort(RandomAccessIterator begin,RandomAccessIterator end)
+{
+    sstl::insertion_sort(begin,end,less<>());
+}
+
+//every element of [begin,end) has a not greater one somewhere before begin
+template <class RandomAccessIterator,class Compare>
+void unguarded_insertion_sort(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    for(RandomAccessIterator i=begin;i!=end;++i)
+        unguarded_linear_insert(i,comp);
+}
+
 
 //quick_sort
 //median
 template <class T>
-const T& median(const T& a,const & b,const & c)
+const T& median(const T& a,const T& b,const T& c)
 {
     return a<b ? (b<c? b:(a<c? c : a)) : (a<c? a:(b<c? c : b));
 }
 
+template <class T,class Compare>
+const T& median(const T& a,const T& b,const T& c,Compare comp)
+{
+    return comp(a,b) ? (comp(b,c)? b:(comp(a,c)? c : a)) : (comp(a,c)? a:(comp(b,c)? c : b));
+}
+
 template <class RandomAccessIterator,class T>
 RandomAccessIterator sort_partition(RandomAccessIterator begin,
                                     RandomAccessIterator end,
                                     const T& pivot)
+{
+    return sstl::sort_partition(begin,end,pivot,less<>());
+}
+
+//unguarded:pivot must be a value of the range,so both scans stop inside it
+template <class RandomAccessIterator,class T,class Compare>
+RandomAccessIterator sort_partition(RandomAccessIterator begin,
+                                    RandomAccessIterator end,
+                                    const T& pivot,Compare comp)
 {
     while(true){
-        while(*begin<pivot)
+        while(comp(*begin,pivot))
             ++begin;
         --end;
-        while(pivot<*end)
+        while(comp(pivot,*end))
             --end;
         if(!(begin<end))
             return begin;
-        iter_swap(begin,end);
+        sstl::iter_swap(begin,end);
         ++begin;
     }
 }
 
-template <class RandomAccessIterator>
-void sort(RandomAccessIterator begin,RandomAccessIterator end)
-{
-    if(end-begin>1){
-        auto pivot_iter=sort_partition(begin,end,median(*begin,*(end-1),*(begin+(end-begin)/2)));
-        sort(begin,pivot_iter);
-        sort(pivot_iter,end);
-    }
-}
-
 
 //push_heap
-template <class RandomAccessIterator,class Offset,class T>
+template <class RandomAccessIterator,class Offset,class T,class Compare>
 void do_push_heap(RandomAccessIterator begin,
-                  Offset top,Offset hole,T value)
+                  Offset top,Offset hole,T value,Compare comp)
 {
 #if USE_RECUR
     Offset parent=(hole-1)/2;
-    if(hole!=top && *(begin+parent)<value){
+    if(hole!=top && comp(*(begin+parent),value)){
         *(begin+hole)=*(begin+parent);
-        do_push_heap(begin,top,parent,value);
+        do_push_heap(begin,top,parent,value,comp);
     }else
         *(begin+hole)=value;
 #else
     Offset parent=(hole-1)/2;
-    while(hole!=top && *(begin+parent)<value){
-        *(begin+hole)=*(begin+parent);
+    while(hole!=top && comp(*(begin+parent),value)){
+        *(begin+hole)=std::move(*(begin+parent));
         hole=parent;
         parent=(hole-1)/2;
     }
-    *(begin+hole)=value;
+    *(begin+hole)=std::move(value);
 #endif
 }
 
-template <class RandomAccessIterator,class Offset,class T>
+template <class RandomAccessIterator,class Offset,class T,class Compare>
 void push_heap_dispatch(RandomAccessIterator begin,
-                        RandomAccessIterator end,Offset*,T*)
+                        RandomAccessIterator end,Offset*,T*,Compare comp)
 {
-    do_push_heap(begin,Offset(0),Offset(end-begin-1),T(*(end-1)));
+    do_push_heap(begin,Offset(0),Offset(end-begin-1),T(std::move(*(end-1))),comp);
+}
+
+template <class RandomAccessIterator,class Compare>
+void push_heap(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    push_heap_dispatch(begin,end,distance_type(begin),value_type(begin),comp);
 }
 
 template <class RandomAccessIterator>
 void push_heap(RandomAccessIterator begin,RandomAccessIterator end)
 {
-    push_heap_dispatch(begin,end,distance_type(begin),value_type(begin));
+    sstl::push_heap(begin,end,less<>());
 }
 
 
 //pop_heap
-template <class RandomAccessIterator,class Offset,class T>
+template <class RandomAccessIterator,class Offset,class T,class Compare>
 void do_adjust_heap(RandomAccessIterator begin,
-                 Offset hole,Offset length,T value)
+                 Offset hole,Offset length,T value,Compare comp)
 {
     Offset top=hole;    //for make_heap
     Offset child=2*hole+1;
     while(child+1<length){
-        if(*(begin+child)<*(begin+(child+1)))
+        if(comp(*(begin+child),*(begin+(child+1))))
             ++child;
-        *(begin+hole)=*(begin+child);
+        *(begin+hole)=std::move(*(begin+child));
         hole=child;
         child=2*child+1;
     }
     if(child+1==length){
-        *(begin+hole)=*(begin+child);
+        *(begin+hole)=std::move(*(begin+child));
         hole=child;
     }
     //'*(begin+hole)=value' is wrong!!!
     //can not compare the last two nodes.
-    do_push_heap(begin,top,hole,value);
+    do_push_heap(begin,top,hole,std::move(value),comp);
 }
 
-template <class RandomAccessIterator,class Offset,class T>
+//move the top of heap [begin,end) to result(outside the heap),*result goes into the heap
+template <class RandomAccessIterator,class Offset,class T,class Compare>
 void pop_heap_dispatch(RandomAccessIterator begin,
                        RandomAccessIterator end,
-                       RandomAccessIterator result,Offset*,T*)
+                       RandomAccessIterator result,Offset*,T*,Compare comp)
 {
-    T value=*result;*result=*begin;
-    do_adjust_heap(begin,Offset(0),Offset(end-begin-1),value);
+    T value=std::move(*result);
+    *result=std::move(*begin);
+    do_adjust_heap(begin,Offset(0),Offset(end-begin),std::move(value),comp);
 }
 
 
+template <class RandomAccessIterator,class Compare>
+void pop_heap(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    pop_heap_dispatch(begin,end-1,end-1,distance_type(begin),value_type(begin),comp);
+}
+
 template <class RandomAccessIterator>
 void pop_heap(RandomAccessIterator begin,RandomAccessIterator end)
 {
-
-    pop_heap_dispatch(begin,end,end-1,distance_type(begin),value_type(begin));
+    sstl::pop_heap(begin,end,less<>());
 }
 
 
 //sort heap
+template <class RandomAccessIterator,class Compare>
+void sort_heap(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    while(end-begin>1)
+        sstl::pop_heap(begin,end--,comp);
+}
+
 template <class RandomAccessIterator>
 void sort_heap(RandomAccessIterator begin,RandomAccessIterator end)
 {
-    while(end-begin>1)
-        pop_heap(begin,end--);
+    sstl::sort_heap(begin,end,less<>());
 }
 
 
 //make heap
-template <class RandomAccessIterator,class Offset,class T>
+template <class RandomAccessIterator,class Offset,class T,class Compare>
 void do_make_heap(RandomAccessIterator begin,
-                  RandomAccessIterator end,Offset*,T*)
+                  RandomAccessIterator end,Offset*,T*,Compare comp)
 {
     if(end-begin<2) return;
     Offset length=end-begin;
 
     Offset parent=(length-2)/2;
     while(true){
-        do_adjust_heap(begin,parent,length,*(begin+parent));
+        do_adjust_heap(begin,parent,length,T(std::move(*(begin+parent))),comp);
         if(parent==0) break;
         --parent;
     }
 
 }
 
+template <class RandomAccessIterator,class Compare>
+void make_heap(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    do_make_heap(begin,end,distance_type(begin),value_type(begin),comp);
+}
+
 template <class RandomAccessIterator>
 void make_heap(RandomAccessIterator begin,RandomAccessIterator end)
 {
-    do_make_heap(begin,end,distance_type(begin),value_type(begin));
+    sstl::make_heap(begin,end,less<>());
 }
 
 
 //partial_sort
+template <class RandomAccessIterator,class Compare>
+void partial_sort(RandomAccessIterator begin,RandomAccessIterator middle,RandomAccessIterator end,Compare comp)
+{
+    if(begin==middle) return;
+    do_make_heap(begin,middle,distance_type(begin),value_type(begin),comp);
+    for(RandomAccessIterator iter=middle;iter!=end;++iter)
+        if(comp(*iter,*begin))
+            pop_heap_dispatch(begin,middle,iter,distance_type(begin),value_type(begin),comp);
+
+    for(;middle-begin>1;--middle)
+        pop_heap_dispatch(begin,middle-1,middle-1,distance_type(begin),value_type(begin),comp);
+}
+
 template <class RandomAccessIterator>
 void partial_sort(RandomAccessIterator begin,RandomAccessIterator middle,RandomAccessIterator end)
 {
-    make_heap(begin,middle);
-    for(RandomAccessIterator iter=middle;iter!=end;++iter)
-        if(*iter<*begin)
-            pop_heap_dispatch(begin,middle,iter,distance_type(begin),value_type(begin));
+    sstl::partial_sort(begin,middle,end,less<>());
+}
+
+
+//introsort:quicksort with a median of three pivot,left for heapsort once the
+//recursion is 2log(n) deep,partitions under sort_threshold are left unsorted
+//and finished by one insertion sort pass.
+constexpr int sort_threshold=16;
+
+template <class Size>
+Size sort_lg(Size n)
+{
+    Size k=0;
+    for(;n>1;n>>=1)
+        ++k;
+    return k;
+}
+
+template <class RandomAccessIterator,class Size,class Compare>
+void introsort_loop(RandomAccessIterator begin,RandomAccessIterator end,
+                    Size depth_limit,Compare comp)
+{
+    while(end-begin>sort_threshold){
+        if(depth_limit==0){
+            sstl::partial_sort(begin,end,end,comp);
+            return;
+        }
+        --depth_limit;
+        auto pivot=sstl::median(*begin,*(begin+(end-begin)/2),*(end-1),comp);    //copy,partition moves the elements.
+        RandomAccessIterator cut=sort_partition(begin,end,pivot,comp);
+        introsort_loop(cut,end,depth_limit,comp);
+        end=cut;
+    }
+}
+
+//the first sort_threshold elements hold the minimum,it guards the rest.
+template <class RandomAccessIterator,class Compare>
+void final_insertion_sort(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    if(end-begin>sort_threshold){
+        sstl::insertion_sort(begin,begin+sort_threshold,comp);
+        unguarded_insertion_sort(begin+sort_threshold,end,comp);
+    }else
+        sstl::insertion_sort(begin,end,comp);
+}
+
+template <class RandomAccessIterator,class Compare>
+void sort(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    if(end-begin>1){
+        introsort_loop(begin,end,sort_lg(end-begin)*2,comp);
+        final_insertion_sort(begin,end,comp);
+    }
+}
+
+template <class RandomAccessIterator>
+void sort(RandomAccessIterator begin,RandomAccessIterator end)
+{
+    sstl::sort(begin,end,less<>());
+}
+
+
+//galloping search:probe 1,2,4,... elements from one end,then binary search the
+//last step.O(log k) for a bound k elements from that end,where lower_bound is O(log n).
+template <class RandomAccessIterator,class T,class Compare>
+RandomAccessIterator gallop_lower_bound(RandomAccessIterator begin,RandomAccessIterator end,
+                                        const T& value,Compare comp)
+{
+    typename iterator_traits<RandomAccessIterator>::difference_type n=end-begin,step=1;
+    while(step<=n && comp(begin[step-1],value)){
+        begin+=step;
+        n-=step;
+        step*=2;
+    }
+    return sstl::lower_bound(begin,begin+(step<=n ? step : n),value,comp);
+}
+
+template <class RandomAccessIterator,class T,class Compare>
+RandomAccessIterator gallop_upper_bound(RandomAccessIterator begin,RandomAccessIterator end,
+                                        const T& value,Compare comp)
+{
+    typename iterator_traits<RandomAccessIterator>::difference_type n=end-begin,step=1;
+    while(step<=n && !comp(value,begin[step-1])){
+        begin+=step;
+        n-=step;
+        step*=2;
+    }
+    return sstl::upper_bound(begin,begin+(step<=n ? step : n),value,comp);
+}
+
+//the same,probing from the end
+template <class RandomAccessIterator,class T,class Compare>
+RandomAccessIterator gallop_lower_bound_back(RandomAccessIterator begin,RandomAccessIterator end,
+                                             const T& value,Compare comp)
+{
+    typename iterator_traits<RandomAccessIterator>::difference_type n=end-begin,step=1;
+    while(step<=n && !comp(*(end-step),value)){
+        end-=step;
+        n-=step;
+        step*=2;
+    }
+    return sstl::lower_bound(end-(step<=n ? step-1 : n),end,value,comp);
+}
+
+template <class RandomAccessIterator,class T,class Compare>
+RandomAccessIterator gallop_upper_bound_back(RandomAccessIterator begin,RandomAccessIterator end,
+                                             const T& value,Compare comp)
+{
+    typename iterator_traits<RandomAccessIterator>::difference_type n=end-begin,step=1;
+    while(step<=n && comp(value,*(end-step))){
+        end-=step;
+        n-=step;
+        step*=2;
+    }
+    return sstl::upper_bound(end-(step<=n ? step-1 : n),end,value,comp);
+}
+
+
+//inplace_merge
+//merges with a buffer move the shorter run into it and merge back into place.
+//they start one element at a time;once one run wins merge_min_gallop times in a
+//row they gallop:find how far it keeps winning and move that block at once,which
+//makes merging presorted or clustered data close to linear in the number of blocks.
+//min_gallop adapts:galloping that pays lowers it,galloping that does not raises it.
+constexpr int merge_min_gallop=7;
+
+//move [begin,end) to result,front to back
+template <class InputIterator,class OutputIterator>
+OutputIterator merge_move(InputIterator begin,InputIterator end,OutputIterator result)
+{
+    for(;begin!=end;++begin,++result)
+        *result=std::move(*begin);
+    return result;
+}
+
+//move [begin,end) to end at result,back to front
+template <class BidirectionalIterator1,class BidirectionalIterator2>
+BidirectionalIterator2 merge_move_backward(BidirectionalIterator1 begin,BidirectionalIterator1 end,
+                                           BidirectionalIterator2 result)
+{
+    while(begin!=end)
+        *--result=std::move(*--end);
+    return result;
+}
+
+//[begin,middle) fits the buffer:merge front to back
+template <class RandomAccessIterator,class Pointer,class Compare>
+void merge_lo(RandomAccessIterator begin,RandomAccessIterator middle,RandomAccessIterator end,
+              Pointer buffer,Compare comp,int& min_gallop)
+{
+    Pointer first1=buffer;
+    Pointer last1=sstl::merge_move(begin,middle,buffer);
+    RandomAccessIterator first2=middle;
+    RandomAccessIterator result=begin;
+
+    while(first1!=last1 && first2!=end){
+        int wins1=0,wins2=0;
+        while(first1!=last1 && first2!=end && (wins1|wins2)<min_gallop){
+            if(comp(*first2,*first1)){
+                *result++=std::move(*first2++);
+                ++wins2;
+                wins1=0;
+            }else{
+                *result++=std::move(*first1++);
+                ++wins1;
+                wins2=0;
+            }
+        }
+
+        while(first1!=last1 && first2!=end){
+            Pointer run1=sstl::gallop_upper_bound(first1,last1,*first2,comp);
+            wins1=run1-first1;
+            result=sstl::merge_move(first1,run1,result);
+            first1=run1;
+            if(first1==last1) break;
+            *result++=std::move(*first2++);
+            if(first2==end) break;
+
+            RandomAccessIterator run2=sstl::gallop_lower_bound(first2,end,*first1,comp);
+            wins2=run2-first2;
+            result=sstl::merge_move(first2,run2,result);
+            first2=run2;
+            if(first2==end) break;
+            *result++=std::move(*first1++);
+
+            if(min_gallop>1)
+                --min_gallop;
+            if(wins1<merge_min_gallop && wins2<merge_min_gallop){
+                min_gallop+=2;
+                break;
+            }
+        }
+    }
+    sstl::merge_move(first1,last1,result);     //what is left of [middle,end) is in place
+}
+
+//[middle,end) fits the buffer:merge back to front
+template <class RandomAccessIterator,class Pointer,class Compare>
+void merge_hi(RandomAccessIterator begin,RandomAccessIterator middle,RandomAccessIterator end,
+              Pointer buffer,Compare comp,int& min_gallop)
+{
+    RandomAccessIterator last1=middle;
+    Pointer first2=buffer;
+    Pointer last2=sstl::merge_move(middle,end,buffer);
+    RandomAccessIterator result=end;
+
+    while(begin!=last1 && first2!=last2){
+        int wins1=0,wins2=0;
+        while(begin!=last1 && first2!=last2 && (wins1|wins2)<min_gallop){
+            if(comp(*(last2-1),*(last1-1))){
+                *--result=std::move(*--last1);
+                ++wins1;
+                wins2=0;
+            }else{
+                *--result=std::move(*--last2);
+                ++wins2;
+                wins1=0;
+            }
+        }
+
+        while(begin!=last1 && first2!=last2){
+            RandomAccessIterator run1=sstl::gallop_upper_bound_back(begin,last1,*(last2-1),comp);
+            wins1=last1-run1;
+            result=sstl::merge_move_backward(run1,last1,result);
+            last1=run1;
+            if(begin==last1) break;
+            *--result=std::move(*--last2);
+            if(first2==last2) break;
+
+            Pointer run2=sstl::gallop_lower_bound_back(first2,last2,*(last1-1),comp);
+            wins2=last2-run2;
+            result=sstl::merge_move_backward(run2,last2,result);
+            last2=run2;
+            if(first2==last2) break;
+            *--result=std::move(*--last1);
+
+            if(min_gallop>1)
+                --min_gallop;
+            if(wins1<merge_min_gallop && wins2<merge_min_gallop){
+                min_gallop+=2;
+                break;
+            }
+        }
+    }
+    sstl::merge_move_backward(first2,last2,result);     //what is left of [begin,middle) is in place
+}
+
+//rotate [begin,middle,end),through the buffer if the shorter side fits.returns the new middle.
+template <class RandomAccessIterator,class Pointer,class Distance>
+RandomAccessIterator rotate_adaptive(RandomAccessIterator begin,RandomAccessIterator middle,
+                                     RandomAccessIterator end,Distance len1,Distance len2,
+                                     Pointer buffer,Distance buffer_size)
+{
+    if(len2<=len1 && len2<=buffer_size){
+        Pointer last=sstl::merge_move(middle,end,buffer);
+        sstl::merge_move_backward(begin,middle,end);
+        return sstl::merge_move(buffer,last,begin);
+    }
+    if(len1<=buffer_size){
+        Pointer last=sstl::merge_move(begin,middle,buffer);
+        RandomAccessIterator result=sstl::merge_move(middle,end,begin);
+        sstl::merge_move(buffer,last,result);
+        return result;
+    }
+    sstl::rotate(begin,middle,end);
+    return begin+len2;
+}
+
+//merge [begin,middle) and [middle,end) with buffer_size elements of scratch space.
+//when neither run fits,the longer one is cut in half,the other at the matching
+//element,the two middle blocks are swapped by a rotation and both halves merged on
+//their own.with no buffer at all this is the buffer-free rotation merge,O(n log n) moves.
+template <class RandomAccessIterator,class Distance,class Pointer,class Compare>
+void merge_adaptive(RandomAccessIterator begin,RandomAccessIterator middle,RandomAccessIterator end,
+                    Distance len1,Distance len2,Pointer buffer,Distance buffer_size,
+                    Compare comp,int& min_gallop)
+{
+    if(len1==0 || len2==0) return;
+    if(len1+len2==2){
+        if(comp(*middle,*begin))
+            sstl::iter_swap(begin,middle);
+        return;
+    }
+    if(len1<=len2 && len1<=buffer_size){
+        sstl::merge_lo(begin,middle,end,buffer,comp,min_gallop);
+        return;
+    }
+    if(len2<=buffer_size){
+        sstl::merge_hi(begin,middle,end,buffer,comp,min_gallop);
+        return;
+    }
+
+    RandomAccessIterator cut1,cut2;
+    if(len1>len2){
+        cut1=begin+len1/2;
+        cut2=sstl::lower_bound(middle,end,*cut1,comp);
+    }else{
+        cut2=middle+len2/2;
+        cut1=sstl::upper_bound(begin,middle,*cut2,comp);
+    }
+    Distance left1=cut1-begin;
+    Distance left2=cut2-middle;
+    RandomAccessIterator new_middle=sstl::rotate_adaptive(cut1,middle,cut2,Distance(len1-left1),left2,
+                                                          buffer,buffer_size);
+    sstl::merge_adaptive(begin,cut1,new_middle,left1,left2,buffer,buffer_size,comp,min_gallop);
+    sstl::merge_adaptive(new_middle,cut2,end,Distance(len1-left1),Distance(len2-left2),
+                         buffer,buffer_size,comp,min_gallop);
+}
+
+//merge the sorted runs [begin,middle) and [middle,end) in place,stable.
+//O(n) with a buffer for the shorter run,O(n log n) without.
+template <class RandomAccessIterator,class Compare>
+void inplace_merge(RandomAccessIterator begin,RandomAccessIterator middle,RandomAccessIterator end,Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+    if(begin==middle || middle==end) return;
+    //what is in place already needs no buffer
+    begin=sstl::gallop_upper_bound(begin,middle,*middle,comp);
+    if(begin==middle) return;
+    end=sstl::gallop_lower_bound_back(middle,end,*(middle-1),comp);
+
+    difference_type len1=middle-begin;
+    difference_type len2=end-middle;
+    temporary_buffer<value_type> buffer(begin,len1<len2 ? len1 : len2);
+    int min_gallop=merge_min_gallop;
+    sstl::merge_adaptive(begin,middle,end,len1,len2,buffer.begin(),difference_type(buffer.size()),comp,min_gallop);
+}
+
+template <class RandomAccessIterator>
+void inplace_merge(RandomAccessIterator begin,RandomAccessIterator middle,RandomAccessIterator end)
+{
+    sstl::inplace_merge(begin,middle,end,less<>());
+}
+
+
+//stable_sort
+//TimSort:the range is cut into natural runs(ascending,or strictly descending and
+//reversed),runs shorter than minrun are extended by binary insertion sort,and runs
+//are merged from a stack whose lengths grow at least like the Fibonacci numbers,
+//so merges stay balanced.merges skip what is already in place and gallop(see
+//inplace_merge),sorted or nearly sorted input costs close to O(n).
+//the buffer is n/2 elements,or less if memory is short:merges that do not fit
+//fall back to rotations(merge_adaptive),down to no buffer at all.
+//
+//usage:
+//  sstl::stable_sort(events.begin(),events.end(),[](const event& a,const event& b){return a.time<b.time;});
+
+//ranges up to this long are one binary insertion sort
+constexpr int stable_sort_min_merge=32;
+
+//[begin,sorted) is sorted:insert the rest,each after its equals
+template <class RandomAccessIterator,class Compare>
+void binary_insertion_sort(RandomAccessIterator begin,RandomAccessIterator sorted,
+                           RandomAccessIterator end,Compare comp)
+{
+    for(;sorted!=end;++sorted){
+        auto value=std::move(*sorted);
+        RandomAccessIterator pos=sstl::upper_bound(begin,sorted,value,comp);
+        sstl::merge_move_backward(pos,sorted,sorted+1);
+        *pos=std::move(value);
+    }
+}
+
+//length of the run at begin,a descending run is reversed
+template <class RandomAccessIterator,class Compare>
+RandomAccessIterator stable_sort_run(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    RandomAccessIterator run=begin+1;
+    if(run==end) return run;
+    if(comp(*run,*begin)){
+        while(++run!=end && comp(*run,*(run-1)));
+        sstl::reverse(begin,run);   //strictly descending:no equal elements change order
+    }else{
+        while(++run!=end && !comp(*run,*(run-1)));
+    }
+    return run;
+}
+
+//n/minrun is a power of 2 or just under one,minrun in [16,32]
+template <class Distance>
+Distance stable_sort_min_run(Distance n)
+{
+    Distance low=0;
+    for(;n>=stable_sort_min_merge;n>>=1)
+        low|=n&1;
+    return n+low;
+}
+
+template <class RandomAccessIterator,class Pointer,class Compare>
+class stable_sort_runs
+{
+public:
+
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+    stable_sort_runs(Pointer buffer,difference_type buffer_size,Compare comp)
+        :_count(0),_buffer(buffer),_buffer_size(buffer_size),_comp(comp),_min_gallop(merge_min_gallop){}
+
+    void push(RandomAccessIterator begin,difference_type len)
+    {
+        _begin[_count]=begin;
+        _len[_count]=len;
+        ++_count;
+    }
+
+    //merge until,from the top,every run is longer than the next two together
+    void collapse()
+    {
+        while(_count>1){
+            int i=_count-2;
+            if((i>0 && _len[i-1]<=_len[i]+_len[i+1]) || (i>1 && _len[i-2]<=_len[i-1]+_len[i])){
+                if(_len[i-1]<_len[i+1])
+                    --i;
+            }else if(_len[i]>_len[i+1]){
+                break;
+            }
+            merge_at(i);
+        }
+    }
+
+    void force_collapse()
+    {
+        while(_count>1){
+            int i=_count-2;
+            if(i>0 && _len[i-1]<_len[i+1])
+                --i;
+            merge_at(i);
+        }
+    }
+
+private:
+
+    //lengths grow at least like the Fibonacci numbers:85 runs are beyond any size_t
+    static constexpr int max_runs=85;
+
+    RandomAccessIterator _begin[max_runs];
+    difference_type _len[max_runs];
+    int _count;
+    Pointer _buffer;
+    difference_type _buffer_size;
+    Compare _comp;
+    int _min_gallop;
+
+
+    //merge runs i and i+1
+    void merge_at(int i)
+    {
+        RandomAccessIterator begin1=_begin[i];
+        RandomAccessIterator begin2=_begin[i+1];
+        difference_type len1=_len[i];
+        difference_type len2=_len[i+1];
+        _len[i]=len1+len2;
+        if(i==_count-3){
+            _begin[i+1]=_begin[i+2];
+            _len[i+1]=_len[i+2];
+        }
+        --_count;
+
+        //the head of run 1 and the tail of run 2 are in place already
+        RandomAccessIterator first1=sstl::gallop_upper_bound(begin1,begin2,*begin2,_comp);
+        len1-=first1-begin1;
+        if(len1==0) return;
+        len2=sstl::gallop_lower_bound_back(begin2,begin2+len2,*(begin2-1),_comp)-begin2;
+        if(len2==0) return;
+        sstl::merge_adaptive(first1,begin2,begin2+len2,len1,len2,_buffer,_buffer_size,_comp,_min_gallop);
+    }
+};
 
-    sort_heap(begin,middle);
+template <class RandomAccessIterator,class Compare>
+void stable_sort(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+    difference_type n=end-begin;
+    if(n<2) return;
+    if(n<stable_sort_min_merge){
+        sstl::binary_insertion_sort(begin,sstl::stable_sort_run(begin,end,comp),end,comp);
+        return;
+    }
+
+    temporary_buffer<value_type> buffer(begin,(n+1)/2);
+    stable_sort_runs<RandomAccessIterator,value_type*,Compare> runs(buffer.begin(),difference_type(buffer.size()),comp);
+    difference_type min_run=sstl::stable_sort_min_run(n);
+    while(begin!=end){
+        RandomAccessIterator run=sstl::stable_sort_run(begin,end,comp);
+        if(run-begin<min_run){
+            RandomAccessIterator forced=end-begin<min_run ? end : begin+min_run;
+            sstl::binary_insertion_sort(begin,run,forced,comp);
+            run=forced;
+        }
+        runs.push(begin,run-begin);
+        runs.collapse();
+        begin=run;
+    }
+    runs.force_collapse();
+}
+
+template <class RandomAccessIterator>
+void stable_sort(RandomAccessIterator begin,RandomAccessIterator end)
+{
+    sstl::stable_sort(begin,end,less<>());
 }
 
 
 //for set
 //set_union
-template <class InputIterator1,class InputIterator2,class OutputIterator>
+template <class InputIterator1,class InputIterator2,class OutputIterator,class Compare>
 OutputIterator set_union(InputIterator1 begin1,InputIterator1 end1,
-                         InputIterator2 begin2,InputIterator2 end2,OutputIterator result)
+                         InputIterator2 begin2,InputIterator2 end2,OutputIterator result,Compare comp)
 {
     while(begin1!=end1 && begin2!=end2){
-        if(*begin1<*begin2){
+        if(comp(*begin1,*begin2)){
             *result=*begin1;
             ++begin1;
-        }else if(*begin2<*begin1){
+        }else if(comp(*begin2,*begin1)){
             *result=*begin2;
             ++begin2;
         }else{
@@ -924,19 +2148,26 @@ OutputIterator set_union(InputIterator1 begin1,InputIterator1 end1,
         }
         ++result;
     }
-    return copy(begin1,end1,copy(begin2,end2,result));
+    return sstl::copy(begin1,end1,sstl::copy(begin2,end2,result));
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator>
+OutputIterator set_union(InputIterator1 begin1,InputIterator1 end1,
+                         InputIterator2 begin2,InputIterator2 end2,OutputIterator result)
+{
+    return sstl::set_union(begin1,end1,begin2,end2,result,less<>());
 }
 
 
 //set_intersection
-template <class InputIterator1,class InputIterator2,class OutputIterator>
+template <class InputIterator1,class InputIterator2,class OutputIterator,class Compare>
 OutputIterator set_intersection(InputIterator1 begin1,InputIterator1 end1,
-                                InputIterator2 begin2,InputIterator2 end2,OutputIterator result)
+                                InputIterator2 begin2,InputIterator2 end2,OutputIterator result,Compare comp)
 {
     while(begin1!=end1 && begin2!=end2){
-        if(*begin1<*begin2){
+        if(comp(*begin1,*begin2)){
             ++begin1;
-        }else if(*begin2<*begin1){
+        }else if(comp(*begin2,*begin1)){
             ++begin2;
         }else{
             *result=*begin1;
@@ -948,41 +2179,54 @@ OutputIterator set_intersection(InputIterator1 begin1,InputIterator1 end1,
     return result;
 }
 
+template <class InputIterator1,class InputIterator2,class OutputIterator>
+OutputIterator set_intersection(InputIterator1 begin1,InputIterator1 end1,
+                                InputIterator2 begin2,InputIterator2 end2,OutputIterator result)
+{
+    return sstl::set_intersection(begin1,end1,begin2,end2,result,less<>());
+}
+
 
 //set_difference
-template <class InputIterator1,class InputIterator2,class OutputIterator>
+//elements of the first range that are not in the second
+template <class InputIterator1,class InputIterator2,class OutputIterator,class Compare>
 OutputIterator set_difference(InputIterator1 begin1,InputIterator1 end1,
-                              InputIterator2 begin2,InputIterator2 end2,OutputIterator result)
+                              InputIterator2 begin2,InputIterator2 end2,OutputIterator result,Compare comp)
 {
     while(begin1!=end1 && begin2!=end2){
-        if(*begin1<*begin2){
+        if(comp(*begin1,*begin2)){
             *result=*begin1;
             ++begin1;
             ++result;
-        }else if(*begin2<*begin1){
-            *result=*begin2;
+        }else if(comp(*begin2,*begin1)){
             ++begin2;
-            ++result;
         }else{
             ++begin1;
             ++begin2;
         }
     }
-    return copy(begin1,end1,result);
+    return sstl::copy(begin1,end1,result);
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator>
+OutputIterator set_difference(InputIterator1 begin1,InputIterator1 end1,
+                              InputIterator2 begin2,InputIterator2 end2,OutputIterator result)
+{
+    return sstl::set_difference(begin1,end1,begin2,end2,result,less<>());
 }
 
 
 //set_symmetic_difference
-template <class InputIterator1,class InputIterator2,class OutputIterator>
+template <class InputIterator1,class InputIterator2,class OutputIterator,class Compare>
 OutputIterator set_symmetric_difference(InputIterator1 begin1,InputIterator1 end1,
-                                        InputIterator2 begin2,InputIterator2 end2,OutputIterator result)
+                                        InputIterator2 begin2,InputIterator2 end2,OutputIterator result,Compare comp)
 {
     while(begin1!=end1 && begin2!=end2){
-        if(*begin1<*begin2){
+        if(comp(*begin1,*begin2)){
             *result=*begin1;
             ++begin1;
             ++result;
-        }else if(*begin2<*begin1){
+        }else if(comp(*begin2,*begin1)){
             *result=*begin2;
             ++begin2;
             ++result;
@@ -991,7 +2235,14 @@ OutputIterator set_symmetric_difference(InputIterator1 begin1,InputIterator1 end
             ++begin2;
         }
     }
-    return copy(begin1,end1,copy(begin2,end2,result));
+    return sstl::copy(begin1,end1,sstl::copy(begin2,end2,result));
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator>
+OutputIterator set_symmetric_difference(InputIterator1 begin1,InputIterator1 end1,
+                                        InputIterator2 begin2,InputIterator2 end2,OutputIterator result)
+{
+    return sstl::set_symmetric_difference(begin1,end1,begin2,end2,result,less<>());
 }
 
 
@@ -88,7 +88,7 @@ void construct(T* p,const Args& ... args)
 template <class T1,class T2>
 void construct(T1* p,T2&& value)
 {
-    new (p) T1(std::move(value));
+    new (p) T1(std::forward<T2>(value));
 }
 
 //to be optimized
@@ -207,6 +207,59 @@ struct simple_alloc
 };
 
 
+//scratch space for the adaptive algorithms(stable_sort,inplace_merge).
+//gets as much of the wanted length as memory allows:an allocation that fails is
+//retried at half the length,down to an empty buffer,never an out of memory error.
+//the elements are constructed by moving *seed through them and back,so they are
+//valid objects to move into and *seed keeps its value.
+template <class T>
+class temporary_buffer
+{
+public:
+
+    template <class ForwardIterator>
+    temporary_buffer(ForwardIterator seed,size_t wanted):_begin(nullptr),_size(0)
+    {
+        if(wanted>size_t(-1)/2/sizeof(T))
+            wanted=size_t(-1)/2/sizeof(T);
+        for(;wanted>0;wanted/=2){
+            _begin=static_cast<T*>(std::malloc(wanted*sizeof(T)));
+            if(_begin) break;
+        }
+        if(!_begin) return;
+        _size=wanted;
+
+        construct(_begin,std::move(*seed));
+        for(size_t i=1;i<_size;++i)
+            construct(_begin+i,std::move(_begin[i-1]));
+        *seed=std::move(_begin[_size-1]);
+    }
+
+    temporary_buffer(const temporary_buffer&)=delete;
+
+    temporary_buffer& operator=(const temporary_buffer&)=delete;
+
+
+    T* begin() const {return _begin;}
+
+    T* end() const {return _begin+_size;}
+
+    size_t size() const {return _size;}
+
+
+    ~temporary_buffer()
+    {
+        destroy(_begin,_size);
+        std::free(_begin);
+    }
+
+private:
+
+    T* _begin;
+    size_t _size;
+};
+
+
 SSTL_NAMESPACE_END
 
 #endif // ALLOCATOR_H_INCLUDED
@@ -0,0 +1,748 @@
+#ifndef BTREE_H_INCLUDED
+#define BTREE_H_INCLUDED
+
+#include "sstl.h"
+#include "allocator.h"
+#include "iterator_traits.h"
+#include "iterator.h"
+#include "function.h"
+#include "utilities.h"
+
+#include <utility>  //std::move
+
+
+SSTL_NAMESPACE_BEGIN
+
+//B+tree:values are kept in leaves only,internal nodes hold separator keys.
+//every node is about NodeSize bytes,so a lookup touches one node per level
+//instead of one node per comparison.
+//
+//invariant:for separators s[0..n) and children c[0..n],
+//          keys in c[i] < s[i] <= keys in c[i+1].
+
+struct btree_node_base
+{
+    btree_node_base* parent;
+    unsigned short count;       //values in a leaf,keys in an internal node
+    bool leaf;
+};
+
+
+template <class Value,size_t Slots>
+struct btree_leaf_node : public btree_node_base
+{
+    btree_leaf_node* prev;
+    btree_leaf_node* next;
+    alignas(Value) unsigned char storage[Slots*sizeof(Value)];
+
+    Value* values() {return reinterpret_cast<Value*>(storage);}
+};
+
+
+template <class Key,size_t Slots>
+struct btree_internal_node : public btree_node_base
+{
+    btree_node_base* children[Slots+1];
+    alignas(Key) unsigned char storage[Slots*sizeof(Key)];
+
+    Key* keys() {return reinterpret_cast<Key*>(storage);}
+};
+
+
+//slots that fit in a node of NodeSize bytes(at least 4)
+constexpr size_t btree_slots(size_t node_size,size_t header_size,size_t slot_size)
+{
+    return node_size>header_size+4*slot_size ? (node_size-header_size)/slot_size : 4;
+}
+
+
+template <class Value,size_t Slots>
+struct btree_iterator
+{
+    //typedefs
+    typedef bidirectional_iterator_tag  iterator_category;
+    typedef Value                       value_type;
+    typedef Value&                      reference;
+    typedef Value*                      pointer;
+    typedef ptrdiff_t                   difference_type;
+
+    typedef btree_iterator                  iterator;
+    typedef btree_leaf_node<Value,Slots>*   leaf_pointer;
+
+
+    //wrapped position
+    leaf_pointer _node;
+    size_t _pos;
+
+
+    //constructors
+    btree_iterator()=default;
+
+    btree_iterator(leaf_pointer node,size_t pos):_node(node),_pos(pos){}
+
+
+    //data access
+    reference operator*() const {return _node->values()[_pos];}
+
+    pointer operator->() const {return &(operator*());}
+
+
+    //arithmetic operations
+    iterator& operator++()
+    {
+        if(++_pos==_node->count && _node->next){
+            _node=_node->next;
+            _pos=0;
+        }
+        return *this;
+    }
+
+    iterator& operator--()
+    {
+        if(_pos==0){
+            _node=_node->prev;
+            _pos=_node->count;
+        }
+        --_pos;
+        return *this;
+    }
+
+    iterator operator++(int)
+    {
+        iterator tmp=*this;
+        ++*this;
+        return tmp;
+    }
+
+    iterator operator--(int)
+    {
+        iterator tmp=*this;
+        --*this;
+        return tmp;
+    }
+
+
+    //relational operations
+    bool operator==(const iterator& iter) const {return _node==iter._node && _pos==iter._pos;}
+
+    bool operator!=(const iterator& iter) const {return !operator==(iter);}
+
+};
+
+
+template <class Key,class Value,class KeyOfValue,class Compare=less<Key>,class Alloc=malloc_alloc,
+          size_t NodeSize=256>
+class btree
+{
+public:
+
+    typedef Key         key_type;
+    typedef Value       value_type;
+    typedef Compare     key_compare;
+
+    static constexpr size_t leaf_slots=
+        btree_slots(NodeSize,sizeof(btree_node_base)+2*sizeof(void*),sizeof(value_type));
+    static constexpr size_t internal_slots=
+        btree_slots(NodeSize,sizeof(btree_node_base)+sizeof(void*),sizeof(key_type)+sizeof(void*));
+
+    typedef btree_iterator<value_type,leaf_slots>       iterator;
+    typedef sstl::reverse_iterator<iterator>            reverse_iterator;
+    typedef sstl::const_iterator<reverse_iterator>      const_reverse_iterator;
+    typedef sstl::const_iterator<iterator>              const_iterator;
+    typedef size_t                                      size_type;
+    typedef value_type*                                 pointer;
+    typedef const value_type*                           const_pointer;
+    typedef value_type&                                 reference;
+    typedef const value_type&                           const_reference;
+    typedef ptrdiff_t                                   difference_type;
+
+
+    //constructors
+    btree(const key_compare& comp=key_compare()):_size(0),_comp(comp){empty_initialize();}
+
+    btree(const btree& t):_size(0),_comp(t._comp)
+    {
+        empty_initialize();
+        append_sorted(t.begin(),t.end());
+    }
+
+
+    //assignment
+    btree& operator=(const btree& t)
+    {
+        if(this==&t) return *this;
+        _comp=t._comp;
+        clear();
+        append_sorted(t.begin(),t.end());
+        return *this;
+    }
+
+
+    //swap
+    void swap(btree& t)
+    {
+        node_pointer tmp_root=_root;_root=t._root;t._root=tmp_root;
+        leaf_pointer tmp_leftmost=_leftmost;_leftmost=t._leftmost;t._leftmost=tmp_leftmost;
+        leaf_pointer tmp_rightmost=_rightmost;_rightmost=t._rightmost;t._rightmost=tmp_rightmost;
+        size_type tmp_size=_size;_size=t._size;t._size=tmp_size;
+        key_compare tmp_comp=_comp;_comp=t._comp;t._comp=tmp_comp;
+    }
+
+    key_compare key_comp() const {return _comp;}
+
+
+    //iterators
+    iterator begin() const {return iterator(_leftmost,0);}
+
+    iterator end() const {return iterator(_rightmost,_rightmost->count);}
+
+    const_iterator cbegin() const {return const_iterator(begin());}
+
+    const_iterator cend() const {return const_iterator(end());}
+
+    reverse_iterator rbegin() const {return reverse_iterator(end());}
+
+    reverse_iterator rend() const {return reverse_iterator(begin());}
+
+    const_reverse_iterator crbegin() const {return const_reverse_iterator(rbegin());}
+
+    const_reverse_iterator crend() const {return const_reverse_iterator(rend());}
+
+
+    //size
+    bool empty() const {return _size==0;}
+
+    size_type size() const {return _size;}
+
+
+    //insert
+    pair<iterator,bool> insert_unique(const_reference value)
+    {
+        const key_type& k=KeyOfValue()(value);
+        leaf_pointer leaf=find_leaf(k);
+        size_type pos=leaf_lower_bound(leaf,k);
+        if(pos<leaf->count && !_comp(k,get_key(leaf,pos)))
+            return {iterator(leaf,pos),false};
+
+        if(leaf->count==leaf_slots){
+            leaf_pointer right=split_leaf(leaf,split_point(leaf,pos));
+            if(pos>leaf->count){
+                pos-=leaf->count;
+                leaf=right;
+            }
+        }
+        shift_right(leaf->values(),pos,leaf->count);
+        construct(leaf->values()+pos,value);
+        ++leaf->count;
+        ++_size;
+        return {iterator(leaf,pos),true};
+    }
+
+    template <class InputIterator>
+    void insert_unique(InputIterator begin,InputIterator end)
+    {
+        for(;begin!=end;++begin)
+            insert_unique(*begin);
+    }
+
+
+    //erase
+    //iterators to other elements are invalidated,the returned one is valid.
+    iterator erase(iterator tar)
+    {
+        leaf_pointer leaf=tar._node;
+        size_type pos=tar._pos;
+
+        destroy(leaf->values()+pos);
+        shift_left(leaf->values(),pos,leaf->count);
+        --leaf->count;
+        --_size;
+
+        if(leaf!=_root && leaf->count<leaf_slots/2)
+            rebalance_leaf(leaf,pos);
+        return normalize(iterator(leaf,pos));
+    }
+
+    size_type erase(const key_type& k)
+    {
+        iterator iter=find(k);
+        if(iter==end()) return 0;
+        erase(iter);
+        return 1;
+    }
+
+    iterator erase(iterator begin,iterator end)
+    {
+        size_type n=sstl::distance(begin,end);
+        while(n--)
+            begin=erase(begin);
+        return begin;
+    }
+
+    void clear()
+    {
+        destroy_subtree(_root);
+        empty_initialize();
+        _size=0;
+    }
+
+
+    //unique(key)
+    iterator find(const key_type& k) const
+    {
+        iterator iter=lower_bound(k);
+        return (iter==end() || _comp(k,KeyOfValue()(*iter))) ? end() : iter;
+    }
+
+    size_type count(const key_type& k) const
+    {
+        return find(k)==end() ? 0 : 1;
+    }
+
+    iterator lower_bound(const key_type& k) const
+    {
+        leaf_pointer leaf=find_leaf(k);
+        return normalize(iterator(leaf,leaf_lower_bound(leaf,k)));
+    }
+
+    iterator upper_bound(const key_type& k) const
+    {
+        leaf_pointer leaf=find_leaf(k);
+        return normalize(iterator(leaf,leaf_upper_bound(leaf,k)));
+    }
+
+    pair<iterator,iterator> equal_range(const key_type& k) const
+    {
+        iterator first=lower_bound(k);
+        iterator last=first;
+        if(last!=end() && !_comp(k,KeyOfValue()(*last)))
+            ++last;
+        return {first,last};
+    }
+
+
+    //destructor
+    ~btree() {destroy_subtree(_root);}
+
+private:
+
+    typedef btree_node_base*                                node_pointer;
+    typedef btree_leaf_node<value_type,leaf_slots>          leaf_node;
+    typedef btree_internal_node<key_type,internal_slots>    internal_node;
+    typedef leaf_node*                                      leaf_pointer;
+    typedef internal_node*                                  internal_pointer;
+
+    typedef simple_alloc<leaf_node,Alloc>       leaf_allocator;
+    typedef simple_alloc<internal_node,Alloc>   internal_allocator;
+
+    node_pointer _root;
+    leaf_pointer _leftmost;
+    leaf_pointer _rightmost;
+    size_type _size;
+    key_compare _comp;
+
+
+    //value->key
+    static const key_type& get_key(leaf_pointer leaf,size_type pos)
+    {
+        return KeyOfValue()(leaf->values()[pos]);
+    }
+
+    static internal_pointer parent_of(node_pointer p)
+    {
+        return static_cast<internal_pointer>(p->parent);
+    }
+
+    static size_type index_in_parent(node_pointer p)
+    {
+        internal_pointer parent=parent_of(p);
+        size_type i=0;
+        while(parent->children[i]!=p)
+            ++i;
+        return i;
+    }
+
+
+    //slot moves(raw storage,the hole is left unconstructed)
+    template <class T>
+    static void shift_right(T* slots,size_type pos,size_type count)
+    {
+        for(size_type i=count;i>pos;--i){
+            construct(slots+i,std::move(slots[i-1]));
+            destroy(slots+i-1);
+        }
+    }
+
+    template <class T>
+    static void shift_left(T* slots,size_type pos,size_type count)
+    {
+        for(size_type i=pos;i+1<count;++i){
+            construct(slots+i,std::move(slots[i+1]));
+            destroy(slots+i+1);
+        }
+    }
+
+    template <class T>
+    static void move_slots(T* from,size_type n,T* to)
+    {
+        for(size_type i=0;i<n;++i){
+            construct(to+i,std::move(from[i]));
+            destroy(from+i);
+        }
+    }
+
+    static void shift_children_right(internal_pointer p,size_type pos)
+    {
+        for(size_type i=p->count+1;i>pos;--i)
+            p->children[i]=p->children[i-1];
+    }
+
+    static void shift_children_left(internal_pointer p,size_type pos)
+    {
+        for(size_type i=pos;i<p->count;++i)
+            p->children[i]=p->children[i+1];
+    }
+
+
+    //allocate and deallocate
+    leaf_pointer create_leaf()
+    {
+        leaf_pointer p=leaf_allocator::allocate();
+        p->parent=nullptr;
+        p->count=0;
+        p->leaf=true;
+        p->prev=nullptr;
+        p->next=nullptr;
+        return p;
+    }
+
+    internal_pointer create_internal()
+    {
+        internal_pointer p=internal_allocator::allocate();
+        p->parent=nullptr;
+        p->count=0;
+        p->leaf=false;
+        return p;
+    }
+
+    void destroy_leaf(leaf_pointer p)
+    {
+        destroy(p->values(),p->values()+p->count);
+        leaf_allocator::deallocate(p);
+    }
+
+    void destroy_internal(internal_pointer p)
+    {
+        destroy(p->keys(),p->keys()+p->count);
+        internal_allocator::deallocate(p);
+    }
+
+    //depth is log(n) in base of the node fan-out,recursion is cheap here.
+    void destroy_subtree(node_pointer p)
+    {
+        if(p->leaf){
+            destroy_leaf(static_cast<leaf_pointer>(p));
+            return;
+        }
+        internal_pointer q=static_cast<internal_pointer>(p);
+        for(size_type i=0;i<=q->count;++i)
+            destroy_subtree(q->children[i]);
+        destroy_internal(q);
+    }
+
+
+    //initialize
+    void empty_initialize()
+    {
+        _leftmost=_rightmost=create_leaf();
+        _root=_leftmost;
+    }
+
+    //copy from an ordered range(no lookups).
+    template <class InputIterator>
+    void append_sorted(InputIterator begin,InputIterator end)
+    {
+        for(;begin!=end;++begin){
+            leaf_pointer leaf=_rightmost;
+            if(leaf->count==leaf_slots)
+                leaf=split_leaf(leaf,leaf->count-1);
+            construct(leaf->values()+leaf->count,*begin);
+            ++leaf->count;
+            ++_size;
+        }
+    }
+
+
+    //search aux
+    leaf_pointer find_leaf(const key_type& k) const
+    {
+        node_pointer p=_root;
+        while(!p->leaf){
+            internal_pointer q=static_cast<internal_pointer>(p);
+            p=q->children[child_index(q,k)];
+        }
+        return static_cast<leaf_pointer>(p);
+    }
+
+    //number of separators not greater than k
+    size_type child_index(internal_pointer q,const key_type& k) const
+    {
+        size_type first=0,len=q->count;
+        while(len>0){
+            size_type half=len >> 1;
+            if(_comp(k,q->keys()[first+half])){
+                len=half;
+            }else{
+                first+=half+1;
+                len-=half+1;
+            }
+        }
+        return first;
+    }
+
+    size_type leaf_lower_bound(leaf_pointer leaf,const key_type& k) const
+    {
+        size_type first=0,len=leaf->count;
+        while(len>0){
+            size_type half=len >> 1;
+            if(_comp(get_key(leaf,first+half),k)){
+                first+=half+1;
+                len-=half+1;
+            }else{
+                len=half;
+            }
+        }
+        return first;
+    }
+
+    size_type leaf_upper_bound(leaf_pointer leaf,const key_type& k) const
+    {
+        size_type first=0,len=leaf->count;
+        while(len>0){
+            size_type half=len >> 1;
+            if(_comp(k,get_key(leaf,first+half))){
+                len=half;
+            }else{
+                first+=half+1;
+                len-=half+1;
+            }
+        }
+        return first;
+    }
+
+    //a position past the last value of a leaf is the first value of the next leaf.
+    iterator normalize(iterator iter) const
+    {
+        if(iter._pos==iter._node->count && iter._node->next){
+            iter._node=iter._node->next;
+            iter._pos=0;
+        }
+        return iter;
+    }
+
+
+    //split
+    //move values [keep,count) of a full leaf to a new right sibling(keep<count)
+    leaf_pointer split_leaf(leaf_pointer leaf,size_type keep)
+    {
+        leaf_pointer right=create_leaf();
+        move_slots(leaf->values()+keep,leaf->count-keep,right->values());
+        right->count=leaf->count-keep;
+        leaf->count=keep;
+
+        right->next=leaf->next;
+        right->prev=leaf;
+        if(leaf->next)
+            leaf->next->prev=right;
+        else
+            _rightmost=right;
+        leaf->next=right;
+
+        insert_parent(leaf,get_key(right,0),right);
+        return right;
+    }
+
+    //appending at the back keeps the left leaf full,otherwise split in half.
+    size_type split_point(leaf_pointer leaf,size_type pos) const
+    {
+        return (leaf==_rightmost && pos==leaf->count) ? leaf->count-1 : leaf->count/2;
+    }
+
+    //insert separator k and its right child after left
+    void insert_parent(node_pointer left,const key_type& k,node_pointer right)
+    {
+        if(left==_root){
+            internal_pointer root=create_internal();
+            construct(root->keys(),k);
+            root->children[0]=left;
+            root->children[1]=right;
+            root->count=1;
+            left->parent=right->parent=root;
+            _root=root;
+            return;
+        }
+
+        internal_pointer p=parent_of(left);
+        size_type i=index_in_parent(left);
+        if(p->count==internal_slots){
+            size_type mid=internal_slots/2;
+            internal_pointer q=create_internal();
+
+            //keys[mid] moves up,keys(mid,count) and children(mid,count] move to q.
+            move_slots(p->keys()+mid+1,p->count-mid-1,q->keys());
+            for(size_type j=mid+1;j<=p->count;++j){
+                q->children[j-mid-1]=p->children[j];
+                p->children[j]->parent=q;
+            }
+            q->count=p->count-mid-1;
+            p->count=mid;
+
+            key_type up=std::move(p->keys()[mid]);
+            destroy(p->keys()+mid);
+            insert_parent(p,up,q);
+
+            if(i>mid){
+                i-=mid+1;
+                p=q;
+            }
+        }
+
+        shift_right(p->keys(),i,p->count);
+        construct(p->keys()+i,k);
+        shift_children_right(p,i+1);
+        p->children[i+1]=right;
+        right->parent=p;
+        ++p->count;
+    }
+
+
+    //rebalance after erase
+    //pos tracks the position of the element after the erased one.
+    void rebalance_leaf(leaf_pointer& leaf,size_type& pos)
+    {
+        const size_type min_count=leaf_slots/2;
+        internal_pointer p=parent_of(leaf);
+        size_type i=index_in_parent(leaf);
+        leaf_pointer left= i>0 ? static_cast<leaf_pointer>(p->children[i-1]) : nullptr;
+        leaf_pointer right= i<p->count ? static_cast<leaf_pointer>(p->children[i+1]) : nullptr;
+
+        if(left && left->count>min_count){                 //borrow from left
+            shift_right(leaf->values(),0,leaf->count);
+            construct(leaf->values(),std::move(left->values()[left->count-1]));
+            destroy(left->values()+left->count-1);
+            --left->count;
+            ++leaf->count;
+            ++pos;
+            p->keys()[i-1]=get_key(leaf,0);
+        }else if(right && right->count>min_count){         //borrow from right
+            construct(leaf->values()+leaf->count,std::move(right->values()[0]));
+            destroy(right->values());
+            shift_left(right->values(),0,right->count);
+            --right->count;
+            ++leaf->count;
+            p->keys()[i]=get_key(right,0);
+        }else if(left){                                     //merge into left
+            pos+=left->count;
+            merge_leaf(left,leaf);
+            erase_parent(p,i-1);
+            leaf=left;
+        }else{                                              //merge right into leaf
+            merge_leaf(leaf,right);
+            erase_parent(p,i);
+        }
+    }
+
+    //append right to left and free right
+    void merge_leaf(leaf_pointer left,leaf_pointer right)
+    {
+        move_slots(right->values(),right->count,left->values()+left->count);
+        left->count+=right->count;
+        right->count=0;
+
+        left->next=right->next;
+        if(right->next)
+            right->next->prev=left;
+        else
+            _rightmost=left;
+        destroy_leaf(right);
+    }
+
+    //remove separator i and child i+1 of p
+    void erase_parent(internal_pointer p,size_type i)
+    {
+        destroy(p->keys()+i);
+        shift_left(p->keys(),i,p->count);
+        shift_children_left(p,i+1);
+        --p->count;
+
+        if(p==_root){
+            if(p->count==0){
+                _root=p->children[0];
+                _root->parent=nullptr;
+                destroy_internal(p);
+            }
+        }else if(p->count<internal_slots/2){
+            rebalance_internal(p);
+        }
+    }
+
+    void rebalance_internal(internal_pointer node)
+    {
+        const size_type min_count=internal_slots/2;
+        internal_pointer p=parent_of(node);
+        size_type i=index_in_parent(node);
+        internal_pointer left= i>0 ? static_cast<internal_pointer>(p->children[i-1]) : nullptr;
+        internal_pointer right= i<p->count ? static_cast<internal_pointer>(p->children[i+1]) : nullptr;
+
+        if(left && left->count>min_count){                 //rotate right through the parent
+            shift_right(node->keys(),0,node->count);
+            shift_children_right(node,0);
+            construct(node->keys(),std::move(p->keys()[i-1]));
+            node->children[0]=left->children[left->count];
+            node->children[0]->parent=node;
+            ++node->count;
+
+            p->keys()[i-1]=std::move(left->keys()[left->count-1]);
+            destroy(left->keys()+left->count-1);
+            --left->count;
+        }else if(right && right->count>min_count){         //rotate left through the parent
+            construct(node->keys()+node->count,std::move(p->keys()[i]));
+            node->children[node->count+1]=right->children[0];
+            node->children[node->count+1]->parent=node;
+            ++node->count;
+
+            p->keys()[i]=std::move(right->keys()[0]);
+            destroy(right->keys());
+            shift_left(right->keys(),0,right->count);
+            shift_children_left(right,0);
+            --right->count;
+        }else if(left){
+            merge_internal(left,p->keys()[i-1],node);
+            erase_parent(p,i-1);
+        }else{
+            merge_internal(node,p->keys()[i],right);
+            erase_parent(p,i);
+        }
+    }
+
+    //append separator k and right to left,and free right
+    void merge_internal(internal_pointer left,const key_type& k,internal_pointer right)
+    {
+        construct(left->keys()+left->count,k);
+        move_slots(right->keys(),right->count,left->keys()+left->count+1);
+        for(size_type j=0;j<=right->count;++j){
+            left->children[left->count+1+j]=right->children[j];
+            right->children[j]->parent=left;
+        }
+        left->count+=right->count+1;
+        right->count=0;
+        destroy_internal(right);
+    }
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // BTREE_H_INCLUDED
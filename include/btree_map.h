@@ -0,0 +1,172 @@
+#ifndef BTREE_MAP_H_INCLUDED
+#define BTREE_MAP_H_INCLUDED
+
+#include "btree.h"
+
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//map with the interface of map.h on a B+tree.
+//unlike map,insert and erase invalidate iterators.
+template <class Key,class Value,class Compare=less<Key>,class Alloc=malloc_alloc,size_t NodeSize=256>
+class btree_map
+{
+public:
+
+    //typedefs
+    typedef Key                         key_type;
+    typedef Value                       data_type;
+    typedef Value                       mapped_type;
+    typedef pair<key_type,data_type>    value_type;
+    typedef Compare                     key_compare;
+
+    class value_compare : public binary_function<value_type,value_type,bool>
+    {
+        friend class btree_map;
+    public:
+
+        bool operator()(const value_type& x,const value_type& y) const {return _comp(x.first,y.first);}
+
+    private:
+
+        Compare _comp;
+
+        value_compare(Compare comp):_comp(comp){}
+
+    };
+
+    typedef btree<key_type,value_type,select1st<value_type>,key_compare,Alloc,NodeSize> rep_type;
+
+    typedef typename rep_type::iterator                 iterator;
+    typedef typename rep_type::const_iterator           const_iterator;
+    typedef typename rep_type::reverse_iterator         reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator   const_reverse_iterator;
+    typedef typename rep_type::pointer                  pointer;
+    typedef typename rep_type::const_pointer            const_pointer;
+    typedef typename rep_type::reference                reference;
+    typedef typename rep_type::const_reference          const_reference;
+    typedef typename rep_type::size_type                size_type;
+    typedef typename rep_type::difference_type          difference_type;
+
+
+    //constructors
+    btree_map():t(key_compare()){}
+
+    explicit btree_map(const key_compare& comp):t(comp){}
+
+    template <class InputIterator>
+    btree_map(InputIterator begin,InputIterator end,const key_compare& comp=key_compare()):t(comp)
+    {
+        t.insert_unique(begin,end);
+    }
+
+    btree_map(std::initializer_list<value_type> il):t(key_compare())
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+    btree_map(const btree_map& m):t(m.t){}
+
+
+    //assignment
+    btree_map& operator=(const btree_map& m) {t=m.t;return *this;}
+
+
+    //iterators
+    iterator begin() const {return t.begin();}
+
+    iterator end() const {return t.end();}
+
+    const_iterator cbegin() const {return t.cbegin();}
+
+    const_iterator cend() const {return t.cend();}
+
+    reverse_iterator rbegin() const {return t.rbegin();}
+
+    reverse_iterator rend() const {return t.rend();}
+
+    const_reverse_iterator crbegin() const {return t.crbegin();}
+
+    const_reverse_iterator crend() const {return t.crend();}
+
+
+    //swap
+    void swap(btree_map& m) {t.swap(m.t);}
+
+
+    //size
+    bool empty() const {return t.empty();}
+
+    size_type size() const {return t.size();}
+
+
+    //data access
+    data_type& operator[](const key_type& k)
+    {
+        iterator iter=t.lower_bound(k);
+        if(iter==end() || t.key_comp()(k,iter->first))
+            iter=t.insert_unique(value_type(k,data_type())).first;
+        return iter->second;
+    }
+
+
+    //insert
+    pair<iterator,bool> insert(const_reference value)
+    {
+        return t.insert_unique(value);
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        t.insert_unique(begin,end);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+
+    //erase
+    iterator erase(iterator tar) {return t.erase(tar);}
+
+    size_type erase(const key_type& k) {return t.erase(k);}
+
+    iterator erase(iterator begin,iterator end) {return t.erase(begin,end);}
+
+    void clear() {t.clear();}
+
+
+    //unique
+    iterator find(const key_type& k) const {return t.find(k);}
+
+    size_type count(const key_type& k) const {return t.count(k);}
+
+    iterator lower_bound(const key_type& k) const {return t.lower_bound(k);}
+
+    iterator upper_bound(const key_type& k) const {return t.upper_bound(k);}
+
+    pair<iterator,iterator> equal_range(const key_type& k) const {return t.equal_range(k);}
+
+
+    //extra
+    key_compare key_comp() const {return t.key_comp();}
+
+    value_compare value_comp() const {return value_compare(t.key_comp());}
+
+    ~btree_map(){}
+
+private:
+
+    rep_type t;
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // BTREE_MAP_H_INCLUDED
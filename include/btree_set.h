@@ -0,0 +1,152 @@
+#ifndef BTREE_SET_H_INCLUDED
+#define BTREE_SET_H_INCLUDED
+
+#include "btree.h"
+
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//set with the interface of set.h on a B+tree.
+//unlike set,insert and erase invalidate iterators.
+template <class Key,class Compare=less<Key>,class Alloc=malloc_alloc,size_t NodeSize=256>
+class btree_set
+{
+public:
+
+    //typedefs
+    typedef Key     key_type;
+    typedef Key     value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+    typedef btree<key_type,value_type,identity<value_type>,key_compare,Alloc,NodeSize> rep_type;
+
+    //common
+    typedef typename rep_type::const_iterator           iterator;
+    typedef typename rep_type::const_iterator           const_iterator;
+    typedef typename rep_type::const_reverse_iterator   reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator   const_reverse_iterator;
+
+    typedef typename rep_type::const_pointer            pointer;
+    typedef typename rep_type::const_pointer            const_pointer;
+    typedef typename rep_type::const_reference          reference;
+    typedef typename rep_type::const_reference          const_reference;
+    typedef typename rep_type::size_type                size_type;
+    typedef typename rep_type::difference_type          difference_type;
+
+
+    //constructors
+    btree_set():t(key_compare()){}
+
+    explicit btree_set(const key_compare& comp):t(comp){}
+
+    template <class InputIterator>
+    btree_set(InputIterator begin,InputIterator end):t(key_compare())
+    {
+        t.insert_unique(begin,end);
+    }
+
+    template <class InputIterator>
+    btree_set(InputIterator begin,InputIterator end,const key_compare& comp):t(comp)
+    {
+        t.insert_unique(begin,end);
+    }
+
+    btree_set(std::initializer_list<key_type> il):t(key_compare())
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+    btree_set(const btree_set& s):t(s.t){}
+
+
+    //assignment
+    btree_set& operator=(const btree_set& s) {t=s.t; return *this;}
+
+
+    //iterators
+    iterator begin() const {return t.cbegin();}
+
+    iterator end() const {return t.cend();}
+
+    reverse_iterator rbegin() const {return t.crbegin();}
+
+    reverse_iterator rend() const {return t.crend();}
+
+
+    //swap
+    void swap(btree_set& s) {t.swap(s.t);}
+
+
+    //size
+    bool empty() const {return t.empty();}
+
+    size_type size() const {return t.size();}
+
+
+    //insert
+    pair<iterator,bool> insert(const_reference value)
+    {
+        pair<typename rep_type::iterator,bool> ret=t.insert_unique(value);
+        return {iterator(ret.first),ret.second};
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        t.insert_unique(begin,end);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+
+    //erase
+    iterator erase(iterator tar) {return iterator(t.erase(tar.base()));}
+
+    size_type erase(const key_type& k) {return t.erase(k);}
+
+    iterator erase(iterator begin,iterator end) {return iterator(t.erase(begin.base(),end.base()));}
+
+    void clear() {t.clear();}
+
+
+    //unique
+    iterator find(const key_type& k) const {return iterator(t.find(k));}
+
+    size_type count(const key_type& k) const {return t.count(k);}
+
+    iterator lower_bound(const key_type& k) const {return iterator(t.lower_bound(k));}
+
+    iterator upper_bound(const key_type& k) const {return iterator(t.upper_bound(k));}
+
+    pair<iterator,iterator> equal_range(const key_type& k) const
+    {
+        pair<typename rep_type::iterator,typename rep_type::iterator> ret=t.equal_range(k);
+        return {iterator(ret.first),iterator(ret.second)};
+    }
+
+
+    //extra
+    key_compare key_comp() const {return t.key_comp();}
+
+    value_compare value_comp() const {return t.key_comp();}
+
+    ~btree_set(){}
+
+
+private:
+
+    rep_type t;
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // BTREE_SET_H_INCLUDED
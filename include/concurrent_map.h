@@ -0,0 +1,245 @@
+#ifndef CONCURRENT_MAP_H_INCLUDED
+#define CONCURRENT_MAP_H_INCLUDED
+
+#include "map.h"
+#include "vector.h"
+#include "hash_fun.h"
+#include "rw_lock.h"
+#include "thread_pool.h"
+
+#include <thread>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//thread-safe map:keys are hashed to Shards independent maps,each behind its own
+//reader-writer lock,so threads working on different shards never contend.
+//no iterators escape a lock:lookups copy the value out,updates take a functor.
+//every call locks a single shard,except the whole-map ones(size,clear,for_each)
+//which visit the shards one at a time and so see no global snapshot.
+template <class Key,class Value,size_t Shards=16,class Hash=hash<Key>,
+          class Compare=less<Key>,class Alloc=malloc_alloc>
+class concurrent_map
+{
+public:
+
+    static_assert(Shards>0,"concurrent_map needs at least one shard");
+
+    //typedefs
+    typedef Key                         key_type;
+    typedef Value                       data_type;
+    typedef Value                       mapped_type;
+    typedef pair<key_type,data_type>    value_type;
+    typedef Hash                        hasher;
+    typedef Compare                     key_compare;
+    typedef size_t                      size_type;
+
+    typedef map<key_type,data_type,key_compare,Alloc> shard_type;
+
+    //result of try_find
+    enum lookup_result {not_found,found,busy};
+
+
+    //constructors
+    concurrent_map(){}
+
+    concurrent_map(const concurrent_map&)=delete;
+
+    concurrent_map& operator=(const concurrent_map&)=delete;
+
+
+    //size
+    size_type shard_count() const {return Shards;}
+
+    size_type size() const
+    {
+        size_type n=0;
+        for(size_type i=0;i<Shards;++i){
+            shared_lock_guard<rw_spin_lock> guard(_shards[i].lock);
+            n+=_shards[i].m.size();
+        }
+        return n;
+    }
+
+    bool empty() const {return size()==0;}
+
+
+    //lookup
+    bool find(const key_type& k,data_type& out) const
+    {
+        const shard& s=shard_of(k);
+        shared_lock_guard<rw_spin_lock> guard(s.lock);
+        typename shard_type::iterator iter=s.m.find(k);
+        if(iter==s.m.end()) return false;
+        out=iter->second;
+        return true;
+    }
+
+    //never waits:busy if a writer holds(or waits for) the shard
+    lookup_result try_find(const key_type& k,data_type& out) const
+    {
+        const shard& s=shard_of(k);
+        if(!s.lock.try_lock_shared()) return busy;
+        typename shard_type::iterator iter=s.m.find(k);
+        bool hit=iter!=s.m.end();
+        if(hit)
+            out=iter->second;
+        s.lock.unlock_shared();
+        return hit ? found : not_found;
+    }
+
+    bool contains(const key_type& k) const
+    {
+        const shard& s=shard_of(k);
+        shared_lock_guard<rw_spin_lock> guard(s.lock);
+        return s.m.find(k)!=s.m.end();
+    }
+
+    size_type count(const key_type& k) const {return contains(k) ? 1 : 0;}
+
+    //call f(const data_type&) under the read lock,returns false if k is absent
+    template <class Function>
+    bool visit(const key_type& k,Function f) const
+    {
+        const shard& s=shard_of(k);
+        shared_lock_guard<rw_spin_lock> guard(s.lock);
+        typename shard_type::iterator iter=s.m.find(k);
+        if(iter==s.m.end()) return false;
+        f(static_cast<const data_type&>(iter->second));
+        return true;
+    }
+
+
+    //modifiers
+    //returns false if k was already present(the value is left alone)
+    bool insert(const value_type& value)
+    {
+        shard& s=shard_of(value.first);
+        unique_lock_guard<rw_spin_lock> guard(s.lock);
+        return s.m.insert(value).second;
+    }
+
+    bool insert(const key_type& k,const data_type& v) {return insert(value_type(k,v));}
+
+    //returns true if k was inserted,false if an existing value was replaced
+    bool insert_or_assign(const key_type& k,const data_type& v)
+    {
+        shard& s=shard_of(k);
+        unique_lock_guard<rw_spin_lock> guard(s.lock);
+        pair<typename shard_type::iterator,bool> ret=s.m.insert(value_type(k,v));
+        if(!ret.second)
+            ret.first->second=v;
+        return ret.second;
+    }
+
+    //call f(data_type&) under the write lock,returns false if k is absent
+    template <class Function>
+    bool update(const key_type& k,Function f)
+    {
+        shard& s=shard_of(k);
+        unique_lock_guard<rw_spin_lock> guard(s.lock);
+        typename shard_type::iterator iter=s.m.find(k);
+        if(iter==s.m.end()) return false;
+        f(iter->second);
+        return true;
+    }
+
+    //call f(data_type&) on the value of k,default constructed first if absent
+    template <class Function>
+    void upsert(const key_type& k,Function f)
+    {
+        shard& s=shard_of(k);
+        unique_lock_guard<rw_spin_lock> guard(s.lock);
+        f(s.m[k]);
+    }
+
+    size_type erase(const key_type& k)
+    {
+        shard& s=shard_of(k);
+        unique_lock_guard<rw_spin_lock> guard(s.lock);
+        typename shard_type::iterator iter=s.m.find(k);
+        if(iter==s.m.end()) return 0;
+        s.m.erase(iter);
+        return 1;
+    }
+
+    void clear()
+    {
+        for(size_type i=0;i<Shards;++i){
+            unique_lock_guard<rw_spin_lock> guard(_shards[i].lock);
+            _shards[i].m.clear();
+        }
+    }
+
+
+    //traversal
+    //f(const key_type&,const data_type&) on every element,one shard read-locked at a time
+    template <class Function>
+    void for_each(Function f) const
+    {
+        for(size_type i=0;i<Shards;++i)
+            for_each_in_shard(i,f);
+    }
+
+    //the same,with the shards spread over up to threads threads(0:one per hardware thread).
+    //f is called concurrently from several threads.
+    template <class Function>
+    void parallel_for_each(Function f,size_type threads=0) const
+    {
+        if(threads==0)
+            threads=std::thread::hardware_concurrency();
+        if(threads>Shards)
+            threads=Shards;
+        if(threads<=1){
+            for_each(f);
+            return;
+        }
+
+        thread_pool::instance().run(threads,[&](size_t t){for_each_stride(f,t,threads);});
+    }
+
+
+    //extra
+    size_type shard_index(const key_type& k) const {return hash_mix(hasher()(k))%Shards;}
+
+    ~concurrent_map(){}
+
+private:
+
+    //one shard per cache line
+    struct alignas(64) shard
+    {
+        mutable rw_spin_lock lock;
+        shard_type m;
+    };
+
+    shard _shards[Shards];
+
+
+    shard& shard_of(const key_type& k) {return _shards[shard_index(k)];}
+
+    const shard& shard_of(const key_type& k) const {return _shards[shard_index(k)];}
+
+    template <class Function>
+    void for_each_in_shard(size_type i,Function& f) const
+    {
+        shared_lock_guard<rw_spin_lock> guard(_shards[i].lock);
+        for(typename shard_type::iterator iter=_shards[i].m.begin();iter!=_shards[i].m.end();++iter)
+            f(static_cast<const key_type&>(iter->first),static_cast<const data_type&>(iter->second));
+    }
+
+    //shards first,first+step,...
+    template <class Function>
+    void for_each_stride(Function f,size_type first,size_type step) const
+    {
+        for(size_type i=first;i<Shards;i+=step)
+            for_each_in_shard(i,f);
+    }
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // CONCURRENT_MAP_H_INCLUDED
@@ -5,6 +5,7 @@
 #include "allocator.h"
 #include "type_traits.h"
 #include "iterator.h"
+#include "algorithm.h"
 
 #include <initializer_list>
 
@@ -136,6 +137,138 @@ struct deque_iterator
 
 };
 
+//copy and copy_backward work one buffer at a time,so each piece is a pointer range
+//(memmove for trivially copyable T).
+template <class T,size_t BufSiz,class OutputIterator>
+OutputIterator deque_copy_out(deque_iterator<T,BufSiz> begin,deque_iterator<T,BufSiz> end,OutputIterator result)
+{
+    for(ptrdiff_t n=end-begin;n>0;){
+        ptrdiff_t len=sstl::min(n,static_cast<ptrdiff_t>(begin._node_end-begin._cur));
+        result=sstl::copy(begin._cur,begin._cur+len,result);
+        begin+=len;
+        n-=len;
+    }
+    return result;
+}
+
+template <class InputIterator,class T,size_t BufSiz>
+deque_iterator<T,BufSiz> deque_copy_in(InputIterator begin,InputIterator end,
+                                       deque_iterator<T,BufSiz> result,input_iterator_tag)
+{
+    for(;begin!=end;++begin,++result)
+        *result=*begin;
+    return result;
+}
+
+template <class RandomAccessIterator,class T,size_t BufSiz>
+deque_iterator<T,BufSiz> deque_copy_in(RandomAccessIterator begin,RandomAccessIterator end,
+                                       deque_iterator<T,BufSiz> result,random_access_iterator_tag)
+{
+    for(ptrdiff_t n=end-begin;n>0;){
+        ptrdiff_t len=sstl::min(n,static_cast<ptrdiff_t>(result._node_end-result._cur));
+        sstl::copy(begin,begin+len,result._cur);
+        begin+=len;
+        result+=len;
+        n-=len;
+    }
+    return result;
+}
+
+template <class T,size_t BufSiz,class OutputIterator>
+OutputIterator copy(deque_iterator<T,BufSiz> begin,deque_iterator<T,BufSiz> end,OutputIterator result)
+{
+    return deque_copy_out(begin,end,result);
+}
+
+template <class InputIterator,class T,size_t BufSiz>
+deque_iterator<T,BufSiz> copy(InputIterator begin,InputIterator end,deque_iterator<T,BufSiz> result)
+{
+    typedef typename iterator_traits<InputIterator>::iterator_category category;
+    return deque_copy_in(begin,end,result,category());
+}
+
+//deque to deque:the source pieces are split again by the destination buffers
+template <class T,size_t BufSiz>
+deque_iterator<T,BufSiz> copy(deque_iterator<T,BufSiz> begin,deque_iterator<T,BufSiz> end,
+                              deque_iterator<T,BufSiz> result)
+{
+    return deque_copy_out(begin,end,result);
+}
+
+
+//backward:the piece ending at iter lies in the previous buffer when iter is at a buffer begin
+template <class T,size_t BufSiz>
+T* deque_piece_end(const deque_iterator<T,BufSiz>& iter)
+{
+    return iter._cur!=iter._node_begin ? iter._cur : *(iter._node-1)+iter.buffer_size();
+}
+
+template <class T,size_t BufSiz>
+ptrdiff_t deque_piece_size(const deque_iterator<T,BufSiz>& iter)
+{
+    return iter._cur!=iter._node_begin ? iter._cur-iter._node_begin : iter.buffer_size();
+}
+
+template <class T,size_t BufSiz,class BidirectionalIterator>
+BidirectionalIterator deque_copy_backward_out(deque_iterator<T,BufSiz> begin,deque_iterator<T,BufSiz> end,
+                                              BidirectionalIterator result)
+{
+    for(ptrdiff_t n=end-begin;n>0;){
+        ptrdiff_t len=sstl::min(n,deque_piece_size(end));
+        T* piece_end=deque_piece_end(end);
+        result=sstl::copy_backward(piece_end-len,piece_end,result);
+        end-=len;
+        n-=len;
+    }
+    return result;
+}
+
+template <class BidirectionalIterator,class T,size_t BufSiz>
+deque_iterator<T,BufSiz> deque_copy_backward_in(BidirectionalIterator begin,BidirectionalIterator end,
+                                                deque_iterator<T,BufSiz> result,bidirectional_iterator_tag)
+{
+    while(begin!=end)
+        *--result=*--end;
+    return result;
+}
+
+template <class RandomAccessIterator,class T,size_t BufSiz>
+deque_iterator<T,BufSiz> deque_copy_backward_in(RandomAccessIterator begin,RandomAccessIterator end,
+                                                deque_iterator<T,BufSiz> result,random_access_iterator_tag)
+{
+    for(ptrdiff_t n=end-begin;n>0;){
+        ptrdiff_t len=sstl::min(n,deque_piece_size(result));
+        sstl::copy_backward(end-len,end,deque_piece_end(result));
+        end-=len;
+        result-=len;
+        n-=len;
+    }
+    return result;
+}
+
+template <class T,size_t BufSiz,class BidirectionalIterator>
+BidirectionalIterator copy_backward(deque_iterator<T,BufSiz> begin,deque_iterator<T,BufSiz> end,
+                                    BidirectionalIterator result)
+{
+    return deque_copy_backward_out(begin,end,result);
+}
+
+template <class BidirectionalIterator,class T,size_t BufSiz>
+deque_iterator<T,BufSiz> copy_backward(BidirectionalIterator begin,BidirectionalIterator end,
+                                       deque_iterator<T,BufSiz> result)
+{
+    typedef typename iterator_traits<BidirectionalIterator>::iterator_category category;
+    return deque_copy_backward_in(begin,end,result,category());
+}
+
+template <class T,size_t BufSiz>
+deque_iterator<T,BufSiz> copy_backward(deque_iterator<T,BufSiz> begin,deque_iterator<T,BufSiz> end,
+                                       deque_iterator<T,BufSiz> result)
+{
+    return deque_copy_backward_out(begin,end,result);
+}
+
+
 //deque
 template <class T,size_t BufSiz=0,class Alloc=malloc_alloc>
 class deque
@@ -343,6 +476,7 @@ private:
         destroy(map_begin,map_end);
         map_allocator::deallocate(_map);
     }
+
     void chk_front_alloc(size_type n=1)
     {
         //calculate the number of nodes need to add.
@@ -434,7 +568,7 @@ private:
             chk_front_alloc();
             ret=_begin--;
             for(;ret!=tar;++ret){       //compare ret._cur & tar._cur
-                construct((ret-1)._cur,*ret);
+                construct((ret-1)._cur,std::move(*ret));
                 destroy(ret._cur);
             }
             construct((--ret)._cur,args...);
@@ -445,7 +579,7 @@ private:
             iterator ret=_end++;
             while(copy_size--){
                 --ret;
-                construct((ret+1)._cur,*ret);
+                construct((ret+1)._cur,std::move(*ret));
                 destroy(ret._cur);
             }
             construct(ret._cur,args...);
@@ -461,7 +595,7 @@ private:
             chk_front_alloc(n);
             ret=_begin;
             for(;ret!=tar;++ret){       //compare ret._cur & tar._cur
-                construct((ret-n)._cur,*ret);
+                construct((ret-n)._cur,std::move(*ret));
                 destroy(ret._cur);
             }
             _begin-=n;
@@ -473,7 +607,7 @@ private:
             iterator ret=_end;
             while(copy_size--){
                 --ret;
-                construct((ret+n)._cur,*ret);
+                construct((ret+n)._cur,std::move(*ret));
                 destroy(ret._cur);
             }
             _end+=n;
@@ -492,7 +626,7 @@ private:
             chk_front_alloc(n);
             ret=_begin;
             for(;ret!=tar;++ret){       //compare ret._cur & tar._cur
-                construct((ret-n)._cur,*ret);
+                construct((ret-n)._cur,std::move(*ret));
                 destroy(ret._cur);
             }
             _begin-=n;
@@ -504,7 +638,7 @@ private:
             iterator ret=_end;
             while(copy_size--){
                 --ret;
-                construct((ret+n)._cur,*ret);
+                construct((ret+n)._cur,std::move(*ret));
                 destroy(ret._cur);
             }
             _end+=n;
@@ -524,13 +658,13 @@ private:
         if(offset<size()/2){
             while(offset--){
                 --tar;
-                construct((tar+n)._cur,*tar);
+                construct((tar+n)._cur,std::move(*tar));
                 destroy(tar._cur);
             }
             _begin+=n;
         }else{
             for(iterator tmp=tar+n;tmp!=_end;++tmp){
-                construct((tmp-n)._cur,*tmp);
+                construct((tmp-n)._cur,std::move(*tmp));
                 destroy(tmp._cur);
             }
             _end-=n;
@@ -0,0 +1,228 @@
+#ifndef EPOCH_H_INCLUDED
+#define EPOCH_H_INCLUDED
+
+#include "sstl.h"
+#include "vector.h"
+
+#include <atomic>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//epoch based reclamation for lock-free containers.
+//a thread reads shared nodes only inside an epoch_guard.an unlinked node is
+//retired instead of freed,and freed once the global epoch has moved two steps:
+//the epoch only moves when every thread inside a guard has seen the current one,
+//so nobody can still hold a pointer to it.
+//
+//usage:
+//  {
+//      epoch_guard guard;
+//      ...read nodes,unlink one...
+//      epoch_retire(node,deleter);
+//  }
+
+struct epoch_retired
+{
+    void* p;
+    void (*deleter)(void*);
+};
+
+
+//per-thread state,records are never unlinked and are reused by later threads
+struct epoch_record
+{
+    std::atomic<unsigned long> state;   //(epoch << 1)|active
+    std::atomic<bool> in_use;
+    epoch_record* next;
+
+    //owner only
+    unsigned nest;
+    unsigned retired;
+    unsigned long limbo_epoch[3];
+    vector<epoch_retired> limbo[3];
+
+    epoch_record():state(0),in_use(true),next(nullptr),nest(0),retired(0)
+    {
+        limbo_epoch[0]=limbo_epoch[1]=limbo_epoch[2]=0;
+    }
+};
+
+
+class epoch_domain
+{
+public:
+
+    //retires per thread between attempts to advance the epoch
+    static constexpr unsigned advance_period=64;
+
+    static epoch_domain& instance()
+    {
+        static epoch_domain domain;
+        return domain;
+    }
+
+
+    //records
+    epoch_record* acquire_record()
+    {
+        for(epoch_record* r=_records.load();r;r=r->next){
+            bool expected=false;
+            if(!r->in_use.load() && r->in_use.compare_exchange_strong(expected,true))
+                return r;
+        }
+        epoch_record* r=new epoch_record;
+        r->next=_records.load();
+        while(!_records.compare_exchange_weak(r->next,r))
+            ;
+        return r;
+    }
+
+    //whatever is still in limbo is freed by the next owner
+    void release_record(epoch_record* r)
+    {
+        reclaim(r);
+        r->in_use.store(false);
+    }
+
+
+    //critical sections(nestable)
+    void enter(epoch_record* r)
+    {
+        if(r->nest++) return;
+        unsigned long e=_epoch.load();
+        r->state.store((e << 1)|1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        reclaim(r);
+    }
+
+    void exit(epoch_record* r)
+    {
+        if(--r->nest) return;
+        r->state.store(r->state.load(std::memory_order_relaxed)&~1ul,std::memory_order_release);
+    }
+
+
+    //retire p,deleter(p) runs once no thread can reach it
+    void retire(epoch_record* r,void* p,void (*deleter)(void*))
+    {
+        unsigned long e=_epoch.load();
+        int i=e%3;
+        if(r->limbo_epoch[i]!=e){
+            free_limbo(r->limbo[i]);    //retired in e-3 or earlier
+            r->limbo_epoch[i]=e;
+        }
+        r->limbo[i].push_back(epoch_retired{p,deleter});
+        if(++r->retired>=advance_period){
+            r->retired=0;
+            try_advance();
+            reclaim(r);
+        }
+    }
+
+    //move the epoch on if every active thread has seen the current one
+    bool try_advance()
+    {
+        unsigned long e=_epoch.load();
+        for(epoch_record* r=_records.load();r;r=r->next){
+            unsigned long s=r->state.load();
+            if((s&1) && (s >> 1)!=e)
+                return false;
+        }
+        return _epoch.compare_exchange_strong(e,e+1);
+    }
+
+    unsigned long epoch() const {return _epoch.load();}
+
+
+    //destructor
+    ~epoch_domain()
+    {
+        epoch_record* r=_records.load();
+        while(r){
+            epoch_record* next=r->next;
+            for(int i=0;i<3;++i)
+                free_limbo(r->limbo[i]);
+            delete r;
+            r=next;
+        }
+    }
+
+private:
+
+    std::atomic<unsigned long> _epoch;
+    std::atomic<epoch_record*> _records;
+
+
+    epoch_domain():_epoch(2),_records(nullptr){}
+
+    epoch_domain(const epoch_domain&)=delete;
+
+    epoch_domain& operator=(const epoch_domain&)=delete;
+
+
+    //free the buckets retired two or more epochs ago
+    void reclaim(epoch_record* r)
+    {
+        unsigned long e=_epoch.load();
+        for(int i=0;i<3;++i)
+            if(r->limbo_epoch[i]+2<=e)
+                free_limbo(r->limbo[i]);
+    }
+
+    static void free_limbo(vector<epoch_retired>& limbo)
+    {
+        for(epoch_retired* p=limbo.begin();p!=limbo.end();++p)
+            p->deleter(p->p);
+        limbo.clear();
+    }
+
+};
+
+
+//the calling thread's record,handed back when the thread exits
+struct epoch_thread
+{
+    epoch_record* record;
+
+    epoch_thread():record(epoch_domain::instance().acquire_record()){}
+
+    ~epoch_thread() {epoch_domain::instance().release_record(record);}
+};
+
+inline epoch_record* epoch_this_thread()
+{
+    static thread_local epoch_thread t;
+    return t.record;
+}
+
+
+//RAII critical section
+class epoch_guard
+{
+public:
+
+    epoch_guard():_record(epoch_this_thread()) {epoch_domain::instance().enter(_record);}
+
+    epoch_guard(const epoch_guard&)=delete;
+
+    epoch_guard& operator=(const epoch_guard&)=delete;
+
+    ~epoch_guard() {epoch_domain::instance().exit(_record);}
+
+private:
+
+    epoch_record* _record;
+};
+
+
+inline void epoch_retire(void* p,void (*deleter)(void*))
+{
+    epoch_domain::instance().retire(epoch_this_thread(),p,deleter);
+}
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // EPOCH_H_INCLUDED
@@ -0,0 +1,745 @@
+#ifndef EXECUTION_H_INCLUDED
+#define EXECUTION_H_INCLUDED
+
+#include "sstl.h"
+#include "iterator_traits.h"
+#include "type_traits.h"
+#include "function.h"
+#include "vector.h"
+#include "algorithm.h"
+#include "numeric.h"
+#include "thread_pool.h"
+
+#include <atomic>
+#include <type_traits>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//execution policies:the first argument of the overloads below.
+//seq runs the plain algorithm.par cuts random-access ranges into chunks and runs
+//them on thread_pool::instance(),other iterators fall back to seq.par_unseq is
+//par;the chunks are already plain loops the compiler may vectorize.
+//with par the functions passed in are called concurrently and must not throw.
+//
+//usage:
+//  sstl::sort(sstl::execution::par,v.begin(),v.end());
+namespace execution
+{
+
+struct sequenced_policy{};
+struct parallel_policy{};
+struct parallel_unsequenced_policy : public parallel_policy{};
+
+constexpr sequenced_policy seq{};
+constexpr parallel_policy par{};
+constexpr parallel_unsequenced_policy par_unseq{};
+
+}
+
+
+//parallel aux
+//ranges below this many elements run on the calling thread
+const size_t parallel_min_size=1 << 15;
+
+//smallest chunk worth a task
+const size_t parallel_min_chunk=1 << 12;
+
+template <class Iterator>
+struct is_random_access
+{
+    static constexpr bool value=std::is_convertible<typename iterator_traits<Iterator>::iterator_category,
+                                                    random_access_iterator_tag>::value;
+};
+
+//about 4 chunks per thread for load balance,1 if n is small
+inline size_t parallel_chunk_count(size_t n)
+{
+    size_t threads=thread_pool::instance().size();
+    if(threads<=1 || n<parallel_min_size) return 1;
+    size_t chunks=n/parallel_min_chunk;
+    return chunks<threads*4 ? chunks : threads*4;
+}
+
+//f(i,lo,hi) for the chunks [lo,hi) of [0,n),concurrently
+template <class Function>
+void parallel_chunks(size_t n,size_t chunks,Function f)
+{
+    thread_pool::instance().run(chunks,[&](size_t i){f(i,n*i/chunks,n*(i+1)/chunks);});
+}
+
+
+//for_each
+template <class RandomAccessIterator,class Function>
+void parallel_for_each(RandomAccessIterator begin,RandomAccessIterator end,Function f,true_type)
+{
+    size_t n=end-begin;
+    parallel_chunks(n,parallel_chunk_count(n),[&](size_t,size_t lo,size_t hi){
+        sstl::for_each(begin+lo,begin+hi,f);
+    });
+}
+
+template <class InputIterator,class Function>
+void parallel_for_each(InputIterator begin,InputIterator end,Function f,false_type)
+{
+    sstl::for_each(begin,end,f);
+}
+
+template <class InputIterator,class Function>
+void for_each(const execution::sequenced_policy&,InputIterator begin,InputIterator end,Function f)
+{
+    sstl::for_each(begin,end,f);
+}
+
+template <class InputIterator,class Function>
+void for_each(const execution::parallel_policy&,InputIterator begin,InputIterator end,Function f)
+{
+    parallel_for_each(begin,end,f,typename bool_tag<is_random_access<InputIterator>::value>::type());
+}
+
+
+//transform
+template <class RandomAccessIterator1,class RandomAccessIterator2,class UnaryOperation>
+RandomAccessIterator2 parallel_transform(RandomAccessIterator1 begin,RandomAccessIterator1 end,
+                                         RandomAccessIterator2 result,UnaryOperation op,true_type)
+{
+    size_t n=end-begin;
+    parallel_chunks(n,parallel_chunk_count(n),[&](size_t,size_t lo,size_t hi){
+        sstl::transform(begin+lo,begin+hi,result+lo,op);
+    });
+    return result+n;
+}
+
+template <class InputIterator,class OutputIterator,class UnaryOperation>
+OutputIterator parallel_transform(InputIterator begin,InputIterator end,
+                                  OutputIterator result,UnaryOperation op,false_type)
+{
+    return sstl::transform(begin,end,result,op);
+}
+
+template <class InputIterator,class OutputIterator,class UnaryOperation>
+OutputIterator transform(const execution::sequenced_policy&,InputIterator begin,InputIterator end,
+                         OutputIterator result,UnaryOperation op)
+{
+    return sstl::transform(begin,end,result,op);
+}
+
+template <class InputIterator,class OutputIterator,class UnaryOperation>
+OutputIterator transform(const execution::parallel_policy&,InputIterator begin,InputIterator end,
+                         OutputIterator result,UnaryOperation op)
+{
+    return parallel_transform(begin,end,result,op,
+                              typename bool_tag<is_random_access<InputIterator>::value
+                                                && is_random_access<OutputIterator>::value>::type());
+}
+
+template <class RandomAccessIterator1,class RandomAccessIterator2,class RandomAccessIterator3,class BinaryOperation>
+RandomAccessIterator3 parallel_transform(RandomAccessIterator1 begin1,RandomAccessIterator1 end1,
+                                         RandomAccessIterator2 begin2,RandomAccessIterator3 result,
+                                         BinaryOperation op,true_type)
+{
+    size_t n=end1-begin1;
+    parallel_chunks(n,parallel_chunk_count(n),[&](size_t,size_t lo,size_t hi){
+        sstl::transform(begin1+lo,begin1+hi,begin2+lo,result+lo,op);
+    });
+    return result+n;
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator,class BinaryOperation>
+OutputIterator parallel_transform(InputIterator1 begin1,InputIterator1 end1,
+                                  InputIterator2 begin2,OutputIterator result,
+                                  BinaryOperation op,false_type)
+{
+    return sstl::transform(begin1,end1,begin2,result,op);
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator,class BinaryOperation>
+OutputIterator transform(const execution::sequenced_policy&,InputIterator1 begin1,InputIterator1 end1,
+                         InputIterator2 begin2,OutputIterator result,BinaryOperation op)
+{
+    return sstl::transform(begin1,end1,begin2,result,op);
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator,class BinaryOperation>
+OutputIterator transform(const execution::parallel_policy&,InputIterator1 begin1,InputIterator1 end1,
+                         InputIterator2 begin2,OutputIterator result,BinaryOperation op)
+{
+    return parallel_transform(begin1,end1,begin2,result,op,
+                              typename bool_tag<is_random_access<InputIterator1>::value
+                                                && is_random_access<InputIterator2>::value
+                                                && is_random_access<OutputIterator>::value>::type());
+}
+
+
+//fill
+template <class RandomAccessIterator,class T>
+void parallel_fill(RandomAccessIterator begin,RandomAccessIterator end,const T& value,true_type)
+{
+    size_t n=end-begin;
+    parallel_chunks(n,parallel_chunk_count(n),[&](size_t,size_t lo,size_t hi){
+        sstl::fill(begin+lo,begin+hi,value);
+    });
+}
+
+template <class ForwardIterator,class T>
+void parallel_fill(ForwardIterator begin,ForwardIterator end,const T& value,false_type)
+{
+    sstl::fill(begin,end,value);
+}
+
+template <class ForwardIterator,class T>
+void fill(const execution::sequenced_policy&,ForwardIterator begin,ForwardIterator end,const T& value)
+{
+    sstl::fill(begin,end,value);
+}
+
+template <class ForwardIterator,class T>
+void fill(const execution::parallel_policy&,ForwardIterator begin,ForwardIterator end,const T& value)
+{
+    parallel_fill(begin,end,value,typename bool_tag<is_random_access<ForwardIterator>::value>::type());
+}
+
+
+//copy
+template <class RandomAccessIterator1,class RandomAccessIterator2>
+RandomAccessIterator2 parallel_copy(RandomAccessIterator1 begin,RandomAccessIterator1 end,
+                                    RandomAccessIterator2 result,true_type)
+{
+    size_t n=end-begin;
+    parallel_chunks(n,parallel_chunk_count(n),[&](size_t,size_t lo,size_t hi){
+        sstl::copy(begin+lo,begin+hi,result+lo);
+    });
+    return result+n;
+}
+
+template <class InputIterator,class OutputIterator>
+OutputIterator parallel_copy(InputIterator begin,InputIterator end,OutputIterator result,false_type)
+{
+    return sstl::copy(begin,end,result);
+}
+
+template <class InputIterator,class OutputIterator>
+OutputIterator copy(const execution::sequenced_policy&,InputIterator begin,InputIterator end,
+                    OutputIterator result)
+{
+    return sstl::copy(begin,end,result);
+}
+
+template <class InputIterator,class OutputIterator>
+OutputIterator copy(const execution::parallel_policy&,InputIterator begin,InputIterator end,
+                    OutputIterator result)
+{
+    return parallel_copy(begin,end,result,
+                         typename bool_tag<is_random_access<InputIterator>::value
+                                           && is_random_access<OutputIterator>::value>::type());
+}
+
+
+//count_if
+template <class RandomAccessIterator,class Predicate>
+typename iterator_traits<RandomAccessIterator>::difference_type
+parallel_count_if(RandomAccessIterator begin,RandomAccessIterator end,Predicate pred,true_type)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+    size_t n=end-begin;
+    size_t chunks=parallel_chunk_count(n);
+    vector<difference_type> counts(chunks,0);
+    parallel_chunks(n,chunks,[&](size_t i,size_t lo,size_t hi){
+        counts.begin()[i]=sstl::count_if(begin+lo,begin+hi,pred);
+    });
+    return sstl::accumulate(counts.begin(),counts.end(),difference_type(0));
+}
+
+template <class InputIterator,class Predicate>
+typename iterator_traits<InputIterator>::difference_type
+parallel_count_if(InputIterator begin,InputIterator end,Predicate pred,false_type)
+{
+    return sstl::count_if(begin,end,pred);
+}
+
+template <class InputIterator,class Predicate>
+typename iterator_traits<InputIterator>::difference_type
+count_if(const execution::sequenced_policy&,InputIterator begin,InputIterator end,Predicate pred)
+{
+    return sstl::count_if(begin,end,pred);
+}
+
+template <class InputIterator,class Predicate>
+typename iterator_traits<InputIterator>::difference_type
+count_if(const execution::parallel_policy&,InputIterator begin,InputIterator end,Predicate pred)
+{
+    return parallel_count_if(begin,end,pred,typename bool_tag<is_random_access<InputIterator>::value>::type());
+}
+
+
+//find_if
+//chunks scan in steps of parallel_find_step and stop once an earlier match is known
+const size_t parallel_find_step=1 << 10;
+
+template <class RandomAccessIterator,class Predicate>
+RandomAccessIterator parallel_find_if(RandomAccessIterator begin,RandomAccessIterator end,
+                                      Predicate pred,true_type)
+{
+    size_t n=end-begin;
+    std::atomic<size_t> found(n);
+    parallel_chunks(n,parallel_chunk_count(n),[&](size_t,size_t lo,size_t hi){
+        for(size_t i=lo;i<hi && i<found.load(std::memory_order_relaxed);i+=parallel_find_step){
+            size_t last=hi-i<parallel_find_step ? hi : i+parallel_find_step;
+            size_t pos=sstl::find_if(begin+i,begin+last,pred)-begin;
+            if(pos!=last){
+                size_t cur=found.load();
+                while(pos<cur && !found.compare_exchange_weak(cur,pos))
+                    ;
+                return;
+            }
+        }
+    });
+    return begin+found.load();
+}
+
+template <class InputIterator,class Predicate>
+InputIterator parallel_find_if(InputIterator begin,InputIterator end,Predicate pred,false_type)
+{
+    return sstl::find_if(begin,end,pred);
+}
+
+template <class InputIterator,class Predicate>
+InputIterator find_if(const execution::sequenced_policy&,InputIterator begin,InputIterator end,Predicate pred)
+{
+    return sstl::find_if(begin,end,pred);
+}
+
+template <class InputIterator,class Predicate>
+InputIterator find_if(const execution::parallel_policy&,InputIterator begin,InputIterator end,Predicate pred)
+{
+    return parallel_find_if(begin,end,pred,typename bool_tag<is_random_access<InputIterator>::value>::type());
+}
+
+
+//merge
+//co-ranking:the output is cut evenly,and for each cut k a binary search finds how
+//many of its first k elements come from the first range.the pieces between cuts
+//are then merged independently,all of the same length.ties keep the first range
+//first,as in the plain merge.
+
+//i such that the first k elements of the merge are [begin1,begin1+i) and [begin2,begin2+(k-i))
+template <class RandomAccessIterator1,class RandomAccessIterator2,class Compare>
+size_t merge_co_rank(RandomAccessIterator1 begin1,size_t n1,RandomAccessIterator2 begin2,size_t n2,
+                     size_t k,Compare comp)
+{
+    size_t lo=k>n2 ? k-n2 : 0;
+    size_t hi=k<n1 ? k : n1;
+    while(true){
+        size_t i=lo+(hi-lo)/2;
+        size_t j=k-i;
+        if(i>0 && j<n2 && comp(begin2[j],begin1[i-1]))         //too many from the first
+            hi=i-1;
+        else if(j>0 && i<n1 && !comp(begin2[j-1],begin1[i]))   //too few from the first
+            lo=i+1;
+        else
+            return i;
+    }
+}
+
+template <class RandomAccessIterator1,class RandomAccessIterator2,class RandomAccessIterator3,class Compare>
+void merge_piece(RandomAccessIterator1 begin1,RandomAccessIterator1 end1,
+                 RandomAccessIterator2 begin2,RandomAccessIterator2 end2,
+                 RandomAccessIterator3 result,Compare comp,false_type)
+{
+    sstl::merge(begin1,end1,begin2,end2,result,comp);
+}
+
+template <class RandomAccessIterator1,class RandomAccessIterator2,class RandomAccessIterator3,class Compare>
+void merge_piece(RandomAccessIterator1 begin1,RandomAccessIterator1 end1,
+                 RandomAccessIterator2 begin2,RandomAccessIterator2 end2,
+                 RandomAccessIterator3 result,Compare comp,true_type)
+{
+    sstl::move_merge(begin1,end1,begin2,end2,result,comp);
+}
+
+//Move:true_type moves the elements,false_type copies them
+template <class RandomAccessIterator1,class RandomAccessIterator2,class RandomAccessIterator3,class Compare,class Move>
+void parallel_merge_pieces(RandomAccessIterator1 begin1,size_t n1,RandomAccessIterator2 begin2,size_t n2,
+                           RandomAccessIterator3 result,Compare comp,Move move)
+{
+    size_t n=n1+n2;
+    size_t chunks=parallel_chunk_count(n);
+    if(chunks<=1){
+        merge_piece(begin1,begin1+n1,begin2,begin2+n2,result,comp,move);
+        return;
+    }
+
+    //all cuts first:a moving piece leaves its inputs moved-from for the searches of the others
+    vector<size_t> cut(chunks+1,0);
+    for(size_t i=1;i<=chunks;++i)
+        cut.begin()[i]=merge_co_rank(begin1,n1,begin2,n2,n*i/chunks,comp);
+    parallel_chunks(n,chunks,[&](size_t i,size_t lo,size_t hi){
+        size_t first1=cut.begin()[i];
+        size_t last1=cut.begin()[i+1];
+        merge_piece(begin1+first1,begin1+last1,begin2+(lo-first1),begin2+(hi-last1),result+lo,comp,move);
+    });
+}
+
+template <class RandomAccessIterator1,class RandomAccessIterator2,class RandomAccessIterator3,class Compare>
+RandomAccessIterator3 parallel_merge(RandomAccessIterator1 begin1,RandomAccessIterator1 end1,
+                                     RandomAccessIterator2 begin2,RandomAccessIterator2 end2,
+                                     RandomAccessIterator3 result,Compare comp,true_type)
+{
+    size_t n1=end1-begin1;
+    size_t n2=end2-begin2;
+    parallel_merge_pieces(begin1,n1,begin2,n2,result,comp,false_type());
+    return result+(n1+n2);
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator,class Compare>
+OutputIterator parallel_merge(InputIterator1 begin1,InputIterator1 end1,
+                              InputIterator2 begin2,InputIterator2 end2,
+                              OutputIterator result,Compare comp,false_type)
+{
+    return sstl::merge(begin1,end1,begin2,end2,result,comp);
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator,class Compare>
+OutputIterator merge(const execution::sequenced_policy&,InputIterator1 begin1,InputIterator1 end1,
+                     InputIterator2 begin2,InputIterator2 end2,OutputIterator result,Compare comp)
+{
+    return sstl::merge(begin1,end1,begin2,end2,result,comp);
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator,class Compare>
+OutputIterator merge(const execution::parallel_policy&,InputIterator1 begin1,InputIterator1 end1,
+                     InputIterator2 begin2,InputIterator2 end2,OutputIterator result,Compare comp)
+{
+    return parallel_merge(begin1,end1,begin2,end2,result,comp,
+                          typename bool_tag<is_random_access<InputIterator1>::value
+                                            && is_random_access<InputIterator2>::value
+                                            && is_random_access<OutputIterator>::value>::type());
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator>
+OutputIterator merge(const execution::sequenced_policy& policy,InputIterator1 begin1,InputIterator1 end1,
+                     InputIterator2 begin2,InputIterator2 end2,OutputIterator result)
+{
+    return sstl::merge(policy,begin1,end1,begin2,end2,result,less<>());
+}
+
+template <class InputIterator1,class InputIterator2,class OutputIterator>
+OutputIterator merge(const execution::parallel_policy& policy,InputIterator1 begin1,InputIterator1 end1,
+                     InputIterator2 begin2,InputIterator2 end2,OutputIterator result)
+{
+    return sstl::merge(policy,begin1,end1,begin2,end2,result,less<>());
+}
+
+
+//sort
+//parallel_sort:sample sort.splitters taken from a sorted random sample cut the
+//range into buckets;chunks are classified and scattered to a buffer concurrently,
+//then the buckets are sorted concurrently and moved back.every splitter also has a
+//bucket of its own for the elements equal to it,which needs no sorting,so many
+//equal keys never pile up in one bucket.not stable.
+//
+//usage:
+//  sstl::parallel_sort(v.begin(),v.end());
+//  sstl::parallel_stable_sort(v.begin(),v.end(),[](const rec& a,const rec& b){return a.key<b.key;});
+
+//sample elements per bucket
+const size_t parallel_sort_oversampling=16;
+
+//bucket of value:2k for the elements between splitters k-1 and k,2k+1 for the ones equal to splitter k
+template <class T,class Compare>
+size_t parallel_sort_bucket(const vector<T>& splitters,const T& value,Compare comp)
+{
+    size_t m=splitters.size();
+    size_t k=sstl::lower_bound(splitters.begin(),splitters.end(),value,comp)-splitters.begin();
+    return 2*k+(k<m && !comp(value,splitters.begin()[k]));
+}
+
+template <class RandomAccessIterator,class Compare>
+void parallel_sort(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+    size_t n=end-begin;
+    size_t chunks=parallel_chunk_count(n);
+    if(chunks<=1){
+        sstl::sort(begin,end,comp);
+        return;
+    }
+
+    //one sample from each of chunks*oversampling strides,at a pseudo-random offset
+    size_t samples=chunks*parallel_sort_oversampling;
+    vector<value_type> sample;
+    unsigned long seed=n;
+    for(size_t i=0;i<samples;++i){
+        size_t lo=n*i/samples;
+        size_t hi=n*(i+1)/samples;
+        seed=seed*6364136223846793005ul+1442695040888963407ul;
+        sample.push_back(begin[lo+(seed >> 33)%(hi-lo)]);
+    }
+    sstl::sort(sample.begin(),sample.end(),comp);
+
+    vector<value_type> splitters;
+    for(size_t i=parallel_sort_oversampling;i<samples;i+=parallel_sort_oversampling)
+        if(splitters.empty() || comp(splitters.back(),sample.begin()[i]))
+            splitters.push_back(sample.begin()[i]);
+
+    //classify:count[c*buckets+b] elements of chunk c go to bucket b
+    size_t buckets=2*splitters.size()+1;
+    vector<unsigned short> bucket_of(n);
+    vector<size_t> count(chunks*buckets,0);
+    parallel_chunks(n,chunks,[&](size_t c,size_t lo,size_t hi){
+        size_t* chunk_count=count.begin()+c*buckets;
+        for(size_t i=lo;i<hi;++i){
+            size_t b=parallel_sort_bucket(splitters,begin[i],comp);
+            bucket_of.begin()[i]=static_cast<unsigned short>(b);
+            ++chunk_count[b];
+        }
+    });
+
+    //count becomes where chunk c writes its first element of bucket b
+    vector<size_t> bucket_begin(buckets+1,0);
+    size_t position=0;
+    for(size_t b=0;b<buckets;++b){
+        bucket_begin.begin()[b]=position;
+        for(size_t c=0;c<chunks;++c){
+            size_t k=count.begin()[c*buckets+b];
+            count.begin()[c*buckets+b]=position;
+            position+=k;
+        }
+    }
+    bucket_begin.begin()[buckets]=n;
+
+    vector<value_type> buffer(begin,end);
+    parallel_chunks(n,chunks,[&](size_t c,size_t lo,size_t hi){
+        size_t* next=count.begin()+c*buckets;
+        for(size_t i=lo;i<hi;++i)
+            buffer.begin()[next[bucket_of.begin()[i]]++]=std::move(begin[i]);
+    });
+
+    thread_pool::instance().run(buckets,[&](size_t b){
+        size_t lo=bucket_begin.begin()[b];
+        size_t hi=bucket_begin.begin()[b+1];
+        if(b%2==0)
+            sstl::sort(buffer.begin()+lo,buffer.begin()+hi,comp);
+        for(size_t i=lo;i<hi;++i)
+            begin[i]=std::move(buffer.begin()[i]);
+    });
+}
+
+template <class RandomAccessIterator>
+void parallel_sort(RandomAccessIterator begin,RandomAccessIterator end)
+{
+    sstl::parallel_sort(begin,end,less<>());
+}
+
+
+//parallel_stable_sort:merge sort.the halves are sorted concurrently,each level
+//merging from the data into a buffer or back(ping-pong),and a big merge is cut
+//into equal pieces by co-ranking and run concurrently too.pieces of at most
+//parallel_min_chunk elements are left to stable_sort.stable.
+
+//sort [data,data+n),the result in data or,if to_buffer,in [buffer,buffer+n).
+//the other one is scratch space.
+template <class RandomAccessIterator1,class RandomAccessIterator2,class Compare>
+void parallel_merge_sort(RandomAccessIterator1 data,RandomAccessIterator2 buffer,size_t n,
+                         bool to_buffer,Compare comp)
+{
+    if(n<=parallel_min_chunk){
+        sstl::stable_sort(data,data+n,comp);
+        if(to_buffer)
+            for(size_t i=0;i<n;++i)
+                buffer[i]=std::move(data[i]);
+        return;
+    }
+
+    size_t half=n/2;
+    thread_pool::instance().parallel_invoke(
+        [&](){parallel_merge_sort(data,buffer,half,!to_buffer,comp);},
+        [&](){parallel_merge_sort(data+half,buffer+half,n-half,!to_buffer,comp);});
+
+    if(to_buffer)
+        parallel_merge_pieces(data,half,data+half,n-half,buffer,comp,true_type());
+    else
+        parallel_merge_pieces(buffer,half,buffer+half,n-half,data,comp,true_type());
+}
+
+template <class RandomAccessIterator,class Compare>
+void parallel_stable_sort(RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+    size_t n=end-begin;
+    if(parallel_chunk_count(n)<=1){
+        sstl::stable_sort(begin,end,comp);
+        return;
+    }
+
+    vector<value_type> buffer(begin,end);
+    parallel_merge_sort(begin,buffer.begin(),n,false,comp);
+}
+
+template <class RandomAccessIterator>
+void parallel_stable_sort(RandomAccessIterator begin,RandomAccessIterator end)
+{
+    sstl::parallel_stable_sort(begin,end,less<>());
+}
+
+
+template <class RandomAccessIterator,class Compare>
+void sort(const execution::sequenced_policy&,RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    sstl::sort(begin,end,comp);
+}
+
+template <class RandomAccessIterator,class Compare>
+void sort(const execution::parallel_policy&,RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    sstl::parallel_sort(begin,end,comp);
+}
+
+template <class RandomAccessIterator>
+void sort(const execution::sequenced_policy& policy,RandomAccessIterator begin,RandomAccessIterator end)
+{
+    sstl::sort(policy,begin,end,less<>());
+}
+
+template <class RandomAccessIterator>
+void sort(const execution::parallel_policy& policy,RandomAccessIterator begin,RandomAccessIterator end)
+{
+    sstl::sort(policy,begin,end,less<>());
+}
+
+
+//stable_sort
+template <class RandomAccessIterator,class Compare>
+void stable_sort(const execution::sequenced_policy&,RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    sstl::stable_sort(begin,end,comp);
+}
+
+template <class RandomAccessIterator,class Compare>
+void stable_sort(const execution::parallel_policy&,RandomAccessIterator begin,RandomAccessIterator end,Compare comp)
+{
+    sstl::parallel_stable_sort(begin,end,comp);
+}
+
+template <class RandomAccessIterator>
+void stable_sort(const execution::sequenced_policy& policy,RandomAccessIterator begin,RandomAccessIterator end)
+{
+    sstl::stable_sort(policy,begin,end,less<>());
+}
+
+template <class RandomAccessIterator>
+void stable_sort(const execution::parallel_policy& policy,RandomAccessIterator begin,RandomAccessIterator end)
+{
+    sstl::stable_sort(policy,begin,end,less<>());
+}
+
+
+//accumulate
+//init op chunk1 op chunk2 ...,in order:op must be associative,not commutative
+template <class RandomAccessIterator,class T,class BinaryOperation>
+T parallel_accumulate(RandomAccessIterator begin,RandomAccessIterator end,T init,BinaryOperation op,true_type)
+{
+    size_t n=end-begin;
+    size_t chunks=parallel_chunk_count(n);
+    vector<T> partial(chunks,init);
+    parallel_chunks(n,chunks,[&](size_t i,size_t lo,size_t hi){
+        partial.begin()[i]=sstl::accumulate(begin+lo+1,begin+hi,T(begin[lo]),op);
+    });
+    for(size_t i=0;i<chunks;++i)
+        init=op(init,partial.begin()[i]);
+    return init;
+}
+
+template <class InputIterator,class T,class BinaryOperation>
+T parallel_accumulate(InputIterator begin,InputIterator end,T init,BinaryOperation op,false_type)
+{
+    return sstl::accumulate(begin,end,init,op);
+}
+
+template <class InputIterator,class T,class BinaryOperation>
+T accumulate(const execution::sequenced_policy&,InputIterator begin,InputIterator end,T init,BinaryOperation op)
+{
+    return sstl::accumulate(begin,end,init,op);
+}
+
+template <class InputIterator,class T,class BinaryOperation>
+T accumulate(const execution::parallel_policy&,InputIterator begin,InputIterator end,T init,BinaryOperation op)
+{
+    if(begin==end) return init;
+    return parallel_accumulate(begin,end,init,op,typename bool_tag<is_random_access<InputIterator>::value>::type());
+}
+
+template <class InputIterator,class T>
+T accumulate(const execution::sequenced_policy& policy,InputIterator begin,InputIterator end,T init)
+{
+    return sstl::accumulate(policy,begin,end,init,plus<>());
+}
+
+template <class InputIterator,class T>
+T accumulate(const execution::parallel_policy& policy,InputIterator begin,InputIterator end,T init)
+{
+    return sstl::accumulate(policy,begin,end,init,plus<>());
+}
+
+
+//inner_product
+template <class RandomAccessIterator1,class RandomAccessIterator2,class T,
+          class BinaryOperation1,class BinaryOperation2>
+T parallel_inner_product(RandomAccessIterator1 begin1,RandomAccessIterator1 end1,RandomAccessIterator2 begin2,
+                         T init,BinaryOperation1 op1,BinaryOperation2 op2,true_type)
+{
+    size_t n=end1-begin1;
+    size_t chunks=parallel_chunk_count(n);
+    vector<T> partial(chunks,init);
+    parallel_chunks(n,chunks,[&](size_t i,size_t lo,size_t hi){
+        partial.begin()[i]=sstl::inner_product(begin1+lo+1,begin1+hi,begin2+lo+1,
+                                               T(op2(begin1[lo],begin2[lo])),op1,op2);
+    });
+    for(size_t i=0;i<chunks;++i)
+        init=op1(init,partial.begin()[i]);
+    return init;
+}
+
+template <class InputIterator1,class InputIterator2,class T,class BinaryOperation1,class BinaryOperation2>
+T parallel_inner_product(InputIterator1 begin1,InputIterator1 end1,InputIterator2 begin2,
+                         T init,BinaryOperation1 op1,BinaryOperation2 op2,false_type)
+{
+    return sstl::inner_product(begin1,end1,begin2,init,op1,op2);
+}
+
+template <class InputIterator1,class InputIterator2,class T,class BinaryOperation1,class BinaryOperation2>
+T inner_product(const execution::sequenced_policy&,InputIterator1 begin1,InputIterator1 end1,
+                InputIterator2 begin2,T init,BinaryOperation1 op1,BinaryOperation2 op2)
+{
+    return sstl::inner_product(begin1,end1,begin2,init,op1,op2);
+}
+
+template <class InputIterator1,class InputIterator2,class T,class BinaryOperation1,class BinaryOperation2>
+T inner_product(const execution::parallel_policy&,InputIterator1 begin1,InputIterator1 end1,
+                InputIterator2 begin2,T init,BinaryOperation1 op1,BinaryOperation2 op2)
+{
+    if(begin1==end1) return init;
+    return parallel_inner_product(begin1,end1,begin2,init,op1,op2,
+                                  typename bool_tag<is_random_access<InputIterator1>::value
+                                                    && is_random_access<InputIterator2>::value>::type());
+}
+
+template <class InputIterator1,class InputIterator2,class T>
+T inner_product(const execution::sequenced_policy& policy,InputIterator1 begin1,InputIterator1 end1,
+                InputIterator2 begin2,T init)
+{
+    return sstl::inner_product(policy,begin1,end1,begin2,init,plus<>(),multiplies<>());
+}
+
+template <class InputIterator1,class InputIterator2,class T>
+T inner_product(const execution::parallel_policy& policy,InputIterator1 begin1,InputIterator1 end1,
+                InputIterator2 begin2,T init)
+{
+    return sstl::inner_product(policy,begin1,end1,begin2,init,plus<>(),multiplies<>());
+}
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // EXECUTION_H_INCLUDED
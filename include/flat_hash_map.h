@@ -0,0 +1,147 @@
+#ifndef FLAT_HASH_MAP_H_INCLUDED
+#define FLAT_HASH_MAP_H_INCLUDED
+
+#include "flat_hashtable.h"
+
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//unordered map on an open addressing table.
+//insert may move elements(rehash),erase does not move the others.
+template <class Key,class Value,class Hash=hash<Key>,class KeyEqual=equal_to<Key>,class Alloc=malloc_alloc>
+class flat_hash_map
+{
+public:
+
+    //typedefs
+    typedef Key                         key_type;
+    typedef Value                       data_type;
+    typedef Value                       mapped_type;
+    typedef pair<key_type,data_type>    value_type;
+    typedef Hash                        hasher;
+    typedef KeyEqual                    key_equal;
+
+    typedef flat_hashtable<key_type,value_type,select1st<value_type>,hasher,key_equal,Alloc> rep_type;
+
+    typedef typename rep_type::iterator         iterator;
+    typedef typename rep_type::const_iterator   const_iterator;
+    typedef typename rep_type::pointer          pointer;
+    typedef typename rep_type::const_pointer    const_pointer;
+    typedef typename rep_type::reference        reference;
+    typedef typename rep_type::const_reference  const_reference;
+    typedef typename rep_type::size_type        size_type;
+    typedef typename rep_type::difference_type  difference_type;
+
+
+    //constructors
+    flat_hash_map():t(){}
+
+    explicit flat_hash_map(size_type n,const hasher& hf=hasher(),const key_equal& eq=key_equal()):t(n,hf,eq){}
+
+    template <class InputIterator>
+    flat_hash_map(InputIterator begin,InputIterator end):t()
+    {
+        t.insert_unique(begin,end);
+    }
+
+    flat_hash_map(std::initializer_list<value_type> il):t(il.size())
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+    flat_hash_map(const flat_hash_map& m):t(m.t){}
+
+
+    //assignment
+    flat_hash_map& operator=(const flat_hash_map& m) {t=m.t;return *this;}
+
+
+    //iterators
+    iterator begin() const {return t.begin();}
+
+    iterator end() const {return t.end();}
+
+    const_iterator cbegin() const {return t.cbegin();}
+
+    const_iterator cend() const {return t.cend();}
+
+
+    //swap
+    void swap(flat_hash_map& m) {t.swap(m.t);}
+
+
+    //size
+    bool empty() const {return t.empty();}
+
+    size_type size() const {return t.size();}
+
+    size_type bucket_count() const {return t.bucket_count();}
+
+    float load_factor() const {return t.load_factor();}
+
+    void reserve(size_type n) {t.reserve(n);}
+
+    void rehash(size_type n) {t.rehash(n);}
+
+
+    //data access
+    data_type& operator[](const key_type& k)
+    {
+        return t.emplace_unique_key(k,in_place_second,k).first->second;
+    }
+
+
+    //insert
+    pair<iterator,bool> insert(const_reference value)
+    {
+        return t.insert_unique(value);
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        t.insert_unique(begin,end);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+
+    //erase
+    iterator erase(iterator tar) {return t.erase(tar);}
+
+    size_type erase(const key_type& k) {return t.erase(k);}
+
+    iterator erase(iterator begin,iterator end) {return t.erase(begin,end);}
+
+    void clear() {t.clear();}
+
+
+    //unique
+    iterator find(const key_type& k) const {return t.find(k);}
+
+    size_type count(const key_type& k) const {return t.count(k);}
+
+
+    //extra
+    hasher hash_funct() const {return t.hash_funct();}
+
+    key_equal key_eq() const {return t.key_eq();}
+
+    ~flat_hash_map(){}
+
+private:
+
+    rep_type t;
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // FLAT_HASH_MAP_H_INCLUDED
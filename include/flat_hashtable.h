@@ -0,0 +1,539 @@
+#ifndef FLAT_HASHTABLE_H_INCLUDED
+#define FLAT_HASHTABLE_H_INCLUDED
+
+#include "sstl.h"
+#include "allocator.h"
+#include "iterator_traits.h"
+#include "iterator.h"
+#include "function.h"
+#include "utilities.h"
+#include "hash_fun.h"
+
+#include <cstring>  //memset
+#include <utility>  //std::move
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SSTL_FLAT_HASH_SSE2 1
+#else
+#define SSTL_FLAT_HASH_SSE2 0
+#endif
+
+
+SSTL_NAMESPACE_BEGIN
+
+//open addressing hash table(SwissTable layout).
+//every slot has a control byte:empty,deleted,or the low 7 bits of the hash(H2) when full.
+//slots are probed 16 at a time:one compare of the group against H2 finds the candidates,
+//and a group with an empty byte ends the probe.groups are visited in triangular order,
+//which covers all of them because the number of groups is a power of two.
+
+typedef signed char flat_hash_ctrl;
+
+constexpr flat_hash_ctrl flat_hash_empty=-128;
+constexpr flat_hash_ctrl flat_hash_deleted=-2;
+constexpr flat_hash_ctrl flat_hash_sentinel=-1;     //ends iteration
+
+
+//bitmask of the matching bytes in a group of control bytes
+struct flat_hash_group
+{
+    static constexpr size_t width=16;
+
+#if SSTL_FLAT_HASH_SSE2
+    __m128i ctrl;
+
+    explicit flat_hash_group(const flat_hash_ctrl* p):ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))){}
+
+    unsigned match(flat_hash_ctrl h2) const
+    {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2),ctrl));
+    }
+
+    unsigned match_empty() const {return match(flat_hash_empty);}
+
+    unsigned match_empty_or_deleted() const
+    {
+        return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(flat_hash_sentinel),ctrl));
+    }
+#else
+    const flat_hash_ctrl* ctrl;
+
+    explicit flat_hash_group(const flat_hash_ctrl* p):ctrl(p){}
+
+    unsigned match(flat_hash_ctrl h2) const
+    {
+        unsigned mask=0;
+        for(size_t i=0;i<width;++i)
+            if(ctrl[i]==h2)
+                mask|=1u << i;
+        return mask;
+    }
+
+    unsigned match_empty() const {return match(flat_hash_empty);}
+
+    unsigned match_empty_or_deleted() const
+    {
+        unsigned mask=0;
+        for(size_t i=0;i<width;++i)
+            if(ctrl[i]<flat_hash_sentinel)
+                mask|=1u << i;
+        return mask;
+    }
+#endif
+};
+
+
+template <class Value>
+struct flat_hashtable_iterator
+{
+    //typedefs
+    typedef forward_iterator_tag    iterator_category;
+    typedef Value                   value_type;
+    typedef Value&                  reference;
+    typedef Value*                  pointer;
+    typedef ptrdiff_t               difference_type;
+
+    typedef flat_hashtable_iterator iterator;
+
+
+    //wrapped pointers
+    const flat_hash_ctrl* _ctrl;
+    Value* _slot;
+
+
+    //constructors
+    flat_hashtable_iterator()=default;
+
+    flat_hashtable_iterator(const flat_hash_ctrl* ctrl,Value* slot):_ctrl(ctrl),_slot(slot){}
+
+
+    //data access
+    reference operator*() const {return *_slot;}
+
+    pointer operator->() const {return _slot;}
+
+
+    //arithmetic operations
+    iterator& operator++()
+    {
+        ++_ctrl;
+        ++_slot;
+        skip_free();
+        return *this;
+    }
+
+    iterator operator++(int)
+    {
+        iterator tmp=*this;
+        ++*this;
+        return tmp;
+    }
+
+    //move to the next full slot(or the sentinel)
+    void skip_free()
+    {
+        while(*_ctrl<flat_hash_sentinel){
+            ++_ctrl;
+            ++_slot;
+        }
+    }
+
+
+    //relational operations
+    bool operator==(const iterator& iter) const {return _ctrl==iter._ctrl;}
+
+    bool operator!=(const iterator& iter) const {return _ctrl!=iter._ctrl;}
+
+};
+
+
+template <class Key,class Value,class KeyOfValue,class Hash=hash<Key>,
+          class KeyEqual=equal_to<Key>,class Alloc=malloc_alloc>
+class flat_hashtable
+{
+public:
+
+    //typedefs
+    typedef Key         key_type;
+    typedef Value       value_type;
+    typedef Hash        hasher;
+    typedef KeyEqual    key_equal;
+
+    typedef flat_hashtable_iterator<value_type>     iterator;
+    typedef sstl::const_iterator<iterator>          const_iterator;
+    typedef size_t                                  size_type;
+    typedef value_type*                             pointer;
+    typedef const value_type*                       const_pointer;
+    typedef value_type&                             reference;
+    typedef const value_type&                       const_reference;
+    typedef ptrdiff_t                               difference_type;
+
+
+    //constructors
+    explicit flat_hashtable(size_type n=0,const hasher& hf=hasher(),const key_equal& eq=key_equal())
+        :_hash(hf),_eq(eq)
+    {
+        empty_initialize();
+        reserve(n);
+    }
+
+    flat_hashtable(const flat_hashtable& ht):_hash(ht._hash),_eq(ht._eq)
+    {
+        empty_initialize();
+        reserve(ht._size);
+        for(iterator iter=ht.begin();iter!=ht.end();++iter)
+            insert_unique_noresize(*iter);
+    }
+
+
+    //assignment
+    flat_hashtable& operator=(const flat_hashtable& ht)
+    {
+        if(this==&ht) return *this;
+        clear();
+        _hash=ht._hash;
+        _eq=ht._eq;
+        reserve(ht._size);
+        for(iterator iter=ht.begin();iter!=ht.end();++iter)
+            insert_unique_noresize(*iter);
+        return *this;
+    }
+
+
+    //swap
+    void swap(flat_hashtable& ht)
+    {
+        flat_hash_ctrl* tmp_ctrl=_ctrl;_ctrl=ht._ctrl;ht._ctrl=tmp_ctrl;
+        pointer tmp_slots=_slots;_slots=ht._slots;ht._slots=tmp_slots;
+        size_type tmp_capacity=_capacity;_capacity=ht._capacity;ht._capacity=tmp_capacity;
+        size_type tmp_size=_size;_size=ht._size;ht._size=tmp_size;
+        size_type tmp_growth=_growth_left;_growth_left=ht._growth_left;ht._growth_left=tmp_growth;
+        hasher tmp_hash=_hash;_hash=ht._hash;ht._hash=tmp_hash;
+        key_equal tmp_eq=_eq;_eq=ht._eq;ht._eq=tmp_eq;
+    }
+
+
+    //iterators
+    iterator begin() const
+    {
+        iterator iter(_ctrl,_slots);
+        iter.skip_free();
+        return iter;
+    }
+
+    iterator end() const {return iterator(_ctrl+_capacity,_slots+_capacity);}
+
+    const_iterator cbegin() const {return const_iterator(begin());}
+
+    const_iterator cend() const {return const_iterator(end());}
+
+
+    //size
+    bool empty() const {return _size==0;}
+
+    size_type size() const {return _size;}
+
+    size_type bucket_count() const {return _capacity;}
+
+    float load_factor() const {return _capacity ? float(_size)/_capacity : 0.0f;}
+
+    hasher hash_funct() const {return _hash;}
+
+    key_equal key_eq() const {return _eq;}
+
+
+    //capacity
+    //make room for n elements without rehashing
+    void reserve(size_type n)
+    {
+        size_type cap=_capacity ? _capacity : flat_hash_group::width;
+        while(max_load(cap)<n)
+            cap*=2;
+        if(n && cap>_capacity)
+            resize(cap);
+    }
+
+    void rehash(size_type n) {reserve(n>_size ? n : _size);}
+
+
+    //insert
+    pair<iterator,bool> insert_unique(const_reference value)
+    {
+        return emplace_unique_key(KeyOfValue()(value),value);
+    }
+
+    //k is the key the value built from args will have:
+    //one probe finds it or the slot for it,nothing is constructed if it is present.
+    template <class... Args>
+    pair<iterator,bool> emplace_unique_key(const key_type& k,Args&&... args)
+    {
+        size_t h=hash_mix(_hash(k));
+        size_type free;
+        size_type i=find_index(k,h,free);
+        if(i!=npos) return {iterator_at(i),false};
+
+        if(free==npos || (_growth_left==0 && _ctrl[free]==flat_hash_empty)){
+            grow();
+            free=find_insert_index(h);
+        }
+        return {iterator_at(place(free,h,std::forward<Args>(args)...)),true};
+    }
+
+    template <class InputIterator>
+    void insert_unique(InputIterator begin,InputIterator end)
+    {
+        for(;begin!=end;++begin)
+            insert_unique(*begin);
+    }
+
+
+    //erase
+    iterator erase(iterator tar)
+    {
+        size_type i=tar._slot-_slots;
+        erase_index(i);
+        ++tar;
+        return tar;
+    }
+
+    size_type erase(const key_type& k)
+    {
+        size_type i=find_index(k,hash_mix(_hash(k)));
+        if(i==npos) return 0;
+        erase_index(i);
+        return 1;
+    }
+
+    iterator erase(iterator begin,iterator end)
+    {
+        while(begin!=end)
+            begin=erase(begin);
+        return end;
+    }
+
+    void clear()
+    {
+        if(!_capacity) return;
+        destroy_slots();
+        memset(_ctrl,flat_hash_empty,_capacity);
+        _size=0;
+        _growth_left=max_load(_capacity);
+    }
+
+
+    //unique(key)
+    iterator find(const key_type& k) const
+    {
+        size_type i=find_index(k,hash_mix(_hash(k)));
+        return i==npos ? end() : iterator_at(i);
+    }
+
+    size_type count(const key_type& k) const {return find(k)==end() ? 0 : 1;}
+
+
+    //destructor
+    ~flat_hashtable()
+    {
+        if(!_capacity) return;
+        destroy_slots();
+        deallocate_arrays(_ctrl,_slots);
+    }
+
+private:
+
+    typedef simple_alloc<flat_hash_ctrl,Alloc>  ctrl_allocator;
+    typedef simple_alloc<value_type,Alloc>      slot_allocator;
+
+    static constexpr size_type npos=size_type(-1);
+
+    flat_hash_ctrl* _ctrl;
+    pointer _slots;
+    size_type _capacity;        //0 or a power of two(multiple of the group width)
+    size_type _size;
+    size_type _growth_left;     //empty slots that can be filled before the load limit
+    hasher _hash;
+    key_equal _eq;
+
+
+    //hash split
+    static size_t h1(size_t h) {return h >> 7;}
+
+    static flat_hash_ctrl h2(size_t h) {return static_cast<flat_hash_ctrl>(h & 0x7f);}
+
+    //7/8 load limit
+    static size_type max_load(size_type cap) {return cap-cap/8;}
+
+    static int lowest_bit(unsigned mask) {return __builtin_ctz(mask);}
+
+    //an empty table points at a lone sentinel,so begin()==end() without allocation.
+    static flat_hash_ctrl* empty_ctrl()
+    {
+        static flat_hash_ctrl sentinel=flat_hash_sentinel;
+        return &sentinel;
+    }
+
+    iterator iterator_at(size_type i) const {return iterator(_ctrl+i,_slots+i);}
+
+    const key_type& get_key(size_type i) const {return KeyOfValue()(_slots[i]);}
+
+
+    //initialize
+    void empty_initialize()
+    {
+        _ctrl=empty_ctrl();
+        _slots=nullptr;
+        _capacity=0;
+        _size=0;
+        _growth_left=0;
+    }
+
+    void deallocate_arrays(flat_hash_ctrl* ctrl,pointer slots)
+    {
+        ctrl_allocator::deallocate(ctrl);
+        slot_allocator::deallocate(slots);
+    }
+
+    void destroy_slots()
+    {
+        for(size_type i=0;i<_capacity;++i)
+            if(_ctrl[i]>=0)
+                destroy(_slots+i);
+    }
+
+
+    //probe
+    size_type find_index(const key_type& k,size_t h) const
+    {
+        if(!_capacity) return npos;
+        size_type mask=_capacity/flat_hash_group::width-1;
+        size_type g=h1(h) & mask;
+        for(size_type step=1;;++step){
+            size_type base=g*flat_hash_group::width;
+            flat_hash_group group(_ctrl+base);
+            for(unsigned m=group.match(h2(h));m;m&=m-1){
+                size_type i=base+lowest_bit(m);
+                if(_eq(k,get_key(i)))
+                    return i;
+            }
+            if(group.match_empty()) return npos;
+            g=(g+step) & mask;
+        }
+    }
+
+    //find_index that also gives the slot k would be inserted at:the first empty or
+    //deleted one on the way,which is what find_insert_index would return.
+    //free is npos if the table has no slots.
+    size_type find_index(const key_type& k,size_t h,size_type& free) const
+    {
+        free=npos;
+        if(!_capacity) return npos;
+        size_type mask=_capacity/flat_hash_group::width-1;
+        size_type g=h1(h) & mask;
+        for(size_type step=1;;++step){
+            size_type base=g*flat_hash_group::width;
+            flat_hash_group group(_ctrl+base);
+            for(unsigned m=group.match(h2(h));m;m&=m-1){
+                size_type i=base+lowest_bit(m);
+                if(_eq(k,get_key(i)))
+                    return i;
+            }
+            if(free==npos){
+                unsigned m=group.match_empty_or_deleted();
+                if(m) free=base+lowest_bit(m);
+            }
+            if(group.match_empty()) return npos;
+            g=(g+step) & mask;
+        }
+    }
+
+    //first empty or deleted slot on the probe sequence of h
+    size_type find_insert_index(size_t h) const
+    {
+        size_type mask=_capacity/flat_hash_group::width-1;
+        size_type g=h1(h) & mask;
+        for(size_type step=1;;++step){
+            size_type base=g*flat_hash_group::width;
+            unsigned m=flat_hash_group(_ctrl+base).match_empty_or_deleted();
+            if(m) return base+lowest_bit(m);
+            g=(g+step) & mask;
+        }
+    }
+
+    template <class... Args>
+    size_type place(size_type i,size_t h,Args&&... args)
+    {
+        new(_slots+i) value_type(std::forward<Args>(args)...);
+        if(_ctrl[i]==flat_hash_empty)
+            --_growth_left;
+        _ctrl[i]=h2(h);
+        ++_size;
+        return i;
+    }
+
+    //caller guarantees the key is absent and there is room
+    void insert_unique_noresize(const_reference value)
+    {
+        size_t h=hash_mix(_hash(KeyOfValue()(value)));
+        place(find_insert_index(h),h,value);
+    }
+
+    void erase_index(size_type i)
+    {
+        destroy(_slots+i);
+        //if the group still has an empty slot no probe ever passed it,so the slot can be empty again.
+        size_type base=i & ~(flat_hash_group::width-1);
+        if(flat_hash_group(_ctrl+base).match_empty()){
+            _ctrl[i]=flat_hash_empty;
+            ++_growth_left;
+        }else{
+            _ctrl[i]=flat_hash_deleted;
+        }
+        --_size;
+    }
+
+
+    //rehash
+    void grow()
+    {
+        if(!_capacity)
+            resize(flat_hash_group::width);
+        else if(_size<=max_load(_capacity)/2)
+            resize(_capacity);              //mostly tombstones,rehash in place
+        else
+            resize(_capacity*2);
+    }
+
+    void resize(size_type new_capacity)
+    {
+        flat_hash_ctrl* old_ctrl=_ctrl;
+        pointer old_slots=_slots;
+        size_type old_capacity=_capacity;
+
+        _ctrl=ctrl_allocator::allocate(new_capacity+1);
+        _slots=slot_allocator::allocate(new_capacity);
+        memset(_ctrl,flat_hash_empty,new_capacity);
+        _ctrl[new_capacity]=flat_hash_sentinel;
+        _capacity=new_capacity;
+        _growth_left=max_load(new_capacity)-_size;
+
+        for(size_type i=0;i<old_capacity;++i){
+            if(old_ctrl[i]<0) continue;
+            size_t h=hash_mix(_hash(KeyOfValue()(old_slots[i])));
+            size_type j=find_insert_index(h);
+            construct(_slots+j,std::move(old_slots[i]));
+            destroy(old_slots+i);
+            _ctrl[j]=h2(h);
+        }
+
+        if(old_capacity)
+            deallocate_arrays(old_ctrl,old_slots);
+    }
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // FLAT_HASHTABLE_H_INCLUDED
@@ -0,0 +1,374 @@
+#ifndef FLAT_MAP_H_INCLUDED
+#define FLAT_MAP_H_INCLUDED
+
+#include "vector.h"
+#include "function.h"
+#include "algorithm.h"
+
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//flat_map keeps keys and values in two parallel vectors,so a lookup only
+//scans the dense key array.the iterator dereferences to a pair of references.
+template <class Key,class Value>
+struct flat_map_iterator
+{
+    //typedefs
+    typedef random_access_iterator_tag          iterator_category;
+    typedef pair<Key,Value>                     value_type;
+    typedef pair<const Key&,Value&>             reference;
+    typedef ptrdiff_t                           difference_type;
+
+    //operator-> has to return something that outlives the call.
+    struct pointer
+    {
+        reference ref;
+
+        explicit pointer(reference r):ref(r){}
+
+        reference* operator->() {return &ref;}
+    };
+
+    typedef flat_map_iterator   iterator;
+
+
+    //wrapped pointers
+    const Key* _key;
+    Value* _value;
+
+
+    //constructors
+    flat_map_iterator()=default;
+
+    flat_map_iterator(const Key* key,Value* value):_key(key),_value(value){}
+
+
+    //data access
+    reference operator*() const {return reference(*_key,*_value);}
+
+    pointer operator->() const {return pointer(operator*());}
+
+    reference operator[](difference_type n) const {return *(*this+n);}
+
+
+    //arithmetic operations
+    iterator& operator++() {++_key;++_value;return *this;}
+
+    iterator& operator--() {--_key;--_value;return *this;}
+
+    iterator operator++(int) {iterator tmp=*this;++*this;return tmp;}
+
+    iterator operator--(int) {iterator tmp=*this;--*this;return tmp;}
+
+    iterator& operator+=(difference_type n) {_key+=n;_value+=n;return *this;}
+
+    iterator& operator-=(difference_type n) {_key-=n;_value-=n;return *this;}
+
+    iterator operator+(difference_type n) const {return iterator(_key+n,_value+n);}
+
+    iterator operator-(difference_type n) const {return iterator(_key-n,_value-n);}
+
+    difference_type operator-(const iterator& iter) const {return _key-iter._key;}
+
+
+    //relational operations
+    bool operator==(const iterator& iter) const {return _key==iter._key;}
+
+    bool operator!=(const iterator& iter) const {return _key!=iter._key;}
+
+    bool operator<(const iterator& iter) const {return _key<iter._key;}
+
+};
+
+
+//map kept as a sorted vector of keys and a vector of values.
+//lookups are binary searches over contiguous keys,single inserts and erases are O(n),
+//so build it with the range insert(one sort and one merge) and read it many times.
+template <class Key,class Value,class Compare=less<Key>,class Alloc=malloc_alloc>
+class flat_map
+{
+public:
+
+    //typedefs
+    typedef Key                         key_type;
+    typedef Value                       data_type;
+    typedef Value                       mapped_type;
+    typedef pair<key_type,data_type>    value_type;
+    typedef Compare                     key_compare;
+
+    typedef flat_map_iterator<key_type,data_type>   iterator;
+    typedef iterator                                const_iterator;
+    typedef sstl::reverse_iterator<iterator>        reverse_iterator;
+    typedef reverse_iterator                        const_reverse_iterator;
+    typedef typename iterator::reference            reference;
+    typedef typename iterator::pointer              pointer;
+    typedef const value_type&                       const_reference;
+    typedef size_t                                  size_type;
+    typedef ptrdiff_t                               difference_type;
+
+
+    //constructors
+    flat_map():_comp(key_compare()){}
+
+    explicit flat_map(const key_compare& comp):_comp(comp){}
+
+    template <class InputIterator>
+    flat_map(InputIterator begin,InputIterator end,const key_compare& comp=key_compare()):_comp(comp)
+    {
+        insert(begin,end);
+    }
+
+    flat_map(std::initializer_list<value_type> il):_comp(key_compare())
+    {
+        insert(il.begin(),il.end());
+    }
+
+    flat_map(const flat_map& m):_keys(m._keys),_values(m._values),_comp(m._comp){}
+
+
+    //assignment
+    flat_map& operator=(const flat_map& m)
+    {
+        _keys=m._keys;
+        _values=m._values;
+        _comp=m._comp;
+        return *this;
+    }
+
+
+    //iterators
+    iterator begin() const {return iterator(_keys.begin(),_values.begin());}
+
+    iterator end() const {return iterator(_keys.end(),_values.end());}
+
+    reverse_iterator rbegin() const {return reverse_iterator(end());}
+
+    reverse_iterator rend() const {return reverse_iterator(begin());}
+
+
+    //swap
+    void swap(flat_map& m)
+    {
+        _keys.swap(m._keys);
+        _values.swap(m._values);
+        key_compare tmp_comp=_comp;_comp=m._comp;m._comp=tmp_comp;
+    }
+
+
+    //size
+    bool empty() const {return _keys.empty();}
+
+    size_type size() const {return _keys.size();}
+
+    size_type capacity() {return _keys.capacity();}
+
+    void reserve(size_type n) {_keys.reserve(n);_values.reserve(n);}
+
+
+    //data access
+    data_type& operator[](const key_type& k)
+    {
+        size_type pos=key_lower_bound(k);
+        if(pos==size() || _comp(k,_keys.begin()[pos]))
+            insert_at(pos,k,data_type());
+        return _values[pos];
+    }
+
+
+    //insert
+    pair<iterator,bool> insert(const_reference value)
+    {
+        size_type pos=key_lower_bound(value.first);
+        if(pos!=size() && !_comp(value.first,_keys.begin()[pos]))
+            return {begin()+pos,false};
+        insert_at(pos,value.first,value.second);
+        return {begin()+pos,true};
+    }
+
+    //append,sort and merge once:O(n+m log m) for m new elements.
+    //for equal keys the element already present,then the first one in the range,is kept.
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        vector<key_type,Alloc> batch_keys;
+        vector<data_type,Alloc> batch_values;
+        for(;begin!=end;++begin){
+            batch_keys.push_back((*begin).first);
+            batch_values.push_back((*begin).second);
+        }
+        if(batch_keys.empty()) return;
+
+        //sort indices by(key,position) so the first of equal keys stays first.
+        vector<size_type,Alloc> order;
+        order.reserve(batch_keys.size());
+        for(size_type i=0;i<batch_keys.size();++i)
+            order.push_back(i);
+        sort(order.begin(),order.end(),index_compare(batch_keys.begin(),_comp));
+
+        merge_unique(batch_keys,batch_values,order);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        insert(il.begin(),il.end());
+    }
+
+
+    //erase
+    iterator erase(iterator tar)
+    {
+        size_type pos=tar-begin();
+        _keys.erase(_keys.begin()+pos);
+        _values.erase(_values.begin()+pos);
+        return begin()+pos;
+    }
+
+    size_type erase(const key_type& k)
+    {
+        iterator iter=find(k);
+        if(iter==end()) return 0;
+        erase(iter);
+        return 1;
+    }
+
+    iterator erase(iterator begin,iterator end)
+    {
+        size_type first=begin-this->begin();
+        size_type last=end-this->begin();
+        _keys.erase(_keys.begin()+first,_keys.begin()+last);
+        _values.erase(_values.begin()+first,_values.begin()+last);
+        return this->begin()+first;
+    }
+
+    void clear() {_keys.clear();_values.clear();}
+
+
+    //unique
+    iterator find(const key_type& k) const
+    {
+        size_type pos=key_lower_bound(k);
+        return (pos==size() || _comp(k,_keys.begin()[pos])) ? end() : begin()+pos;
+    }
+
+    size_type count(const key_type& k) const {return find(k)==end() ? 0 : 1;}
+
+    iterator lower_bound(const key_type& k) const {return begin()+key_lower_bound(k);}
+
+    iterator upper_bound(const key_type& k) const
+    {
+        return begin()+(sstl::upper_bound(_keys.begin(),_keys.end(),k,_comp)-_keys.begin());
+    }
+
+    pair<iterator,iterator> equal_range(const key_type& k) const
+    {
+        iterator first=lower_bound(k);
+        iterator last=first;
+        if(last!=end() && !_comp(k,*last._key))
+            ++last;
+        return {first,last};
+    }
+
+
+    //extra
+    key_compare key_comp() const {return _comp;}
+
+    ~flat_map(){}
+
+private:
+
+    vector<key_type,Alloc> _keys;
+    vector<data_type,Alloc> _values;
+    key_compare _comp;
+
+
+    //compare indices of a key array by(key,index)
+    struct index_compare
+    {
+        const key_type* keys;
+        key_compare comp;
+
+        index_compare(const key_type* k,const key_compare& c):keys(k),comp(c){}
+
+        bool operator()(size_type a,size_type b) const
+        {
+            return comp(keys[a],keys[b]) || (!comp(keys[b],keys[a]) && a<b);
+        }
+    };
+
+
+    size_type key_lower_bound(const key_type& k) const
+    {
+        return sstl::lower_bound(_keys.begin(),_keys.end(),k,_comp)-_keys.begin();
+    }
+
+    void insert_at(size_type pos,const key_type& k,const data_type& value)
+    {
+        _keys.insert(_keys.begin()+pos,k);
+        _values.insert(_values.begin()+pos,value);
+    }
+
+    //merge the batch(visited through order) into the map,
+    //existing keys win and later duplicates in the batch are dropped.
+    template <class KeyVector,class ValueVector,class OrderVector>
+    void merge_unique(KeyVector& batch_keys,ValueVector& batch_values,OrderVector& order)
+    {
+        vector<key_type,Alloc> keys;
+        vector<data_type,Alloc> values;
+        keys.reserve(_keys.size()+order.size());
+        values.reserve(_keys.size()+order.size());
+
+        //all inputs are thrown away afterwards,so their elements are moved.
+        //a batch run is moved only after skip_equal has compared past it.
+        key_type* bk=batch_keys.begin();
+        data_type* bv=batch_values.begin();
+        key_type* ok=_keys.begin();
+        data_type* ov=_values.begin();
+        size_type i=0,n=_keys.size();
+        size_type j=0,m=order.size();
+        while(i<n && j<m){
+            if(_comp(bk[order[j]],ok[i])){
+                size_type first=order[j];
+                j=skip_equal(bk,order,j);
+                keys.push_back(std::move(bk[first]));
+                values.push_back(std::move(bv[first]));
+            }else{
+                if(!_comp(ok[i],bk[order[j]]))
+                    j=skip_equal(bk,order,j);
+                keys.push_back(std::move(ok[i]));
+                values.push_back(std::move(ov[i]));
+                ++i;
+            }
+        }
+        for(;i<n;++i){
+            keys.push_back(std::move(ok[i]));
+            values.push_back(std::move(ov[i]));
+        }
+        while(j<m){
+            size_type first=order[j];
+            j=skip_equal(bk,order,j);
+            keys.push_back(std::move(bk[first]));
+            values.push_back(std::move(bv[first]));
+        }
+        _keys.swap(keys);
+        _values.swap(values);
+    }
+
+    //index past the run of keys equal to the j-th one
+    template <class OrderVector>
+    size_type skip_equal(const key_type* bk,OrderVector& order,size_type j) const
+    {
+        size_type run=j;
+        while(++j<order.size() && !_comp(bk[order[run]],bk[order[j]]))
+            ;
+        return j;
+    }
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // FLAT_MAP_H_INCLUDED
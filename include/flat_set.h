@@ -0,0 +1,219 @@
+#ifndef FLAT_SET_H_INCLUDED
+#define FLAT_SET_H_INCLUDED
+
+#include "vector.h"
+#include "function.h"
+#include "algorithm.h"
+
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//set kept as a sorted vector.
+//lookups are binary searches over contiguous memory,single inserts and erases are O(n),
+//so build it with the range insert(one sort and one merge) and read it many times.
+template <class Key,class Compare=less<Key>,class Alloc=malloc_alloc>
+class flat_set
+{
+public:
+
+    //typedefs
+    typedef Key     key_type;
+    typedef Key     value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+    typedef vector<key_type,Alloc> rep_type;
+
+    typedef const value_type*                   iterator;
+    typedef const value_type*                   const_iterator;
+    typedef sstl::reverse_iterator<iterator>    reverse_iterator;
+    typedef sstl::reverse_iterator<iterator>    const_reverse_iterator;
+
+    typedef const value_type*                   pointer;
+    typedef const value_type*                   const_pointer;
+    typedef const value_type&                   reference;
+    typedef const value_type&                   const_reference;
+    typedef size_t                              size_type;
+    typedef ptrdiff_t                           difference_type;
+
+
+    //constructors
+    flat_set():_comp(key_compare()){}
+
+    explicit flat_set(const key_compare& comp):_comp(comp){}
+
+    template <class InputIterator>
+    flat_set(InputIterator begin,InputIterator end,const key_compare& comp=key_compare()):_comp(comp)
+    {
+        insert(begin,end);
+    }
+
+    flat_set(std::initializer_list<key_type> il):_comp(key_compare())
+    {
+        insert(il.begin(),il.end());
+    }
+
+    flat_set(const flat_set& s):_keys(s._keys),_comp(s._comp){}
+
+
+    //assignment
+    flat_set& operator=(const flat_set& s) {_keys=s._keys;_comp=s._comp;return *this;}
+
+
+    //iterators
+    iterator begin() const {return _keys.begin();}
+
+    iterator end() const {return _keys.end();}
+
+    reverse_iterator rbegin() const {return reverse_iterator(end());}
+
+    reverse_iterator rend() const {return reverse_iterator(begin());}
+
+
+    //swap
+    void swap(flat_set& s)
+    {
+        _keys.swap(s._keys);
+        key_compare tmp_comp=_comp;_comp=s._comp;s._comp=tmp_comp;
+    }
+
+
+    //size
+    bool empty() const {return _keys.empty();}
+
+    size_type size() const {return _keys.size();}
+
+    size_type capacity() {return _keys.capacity();}
+
+    void reserve(size_type n) {_keys.reserve(n);}
+
+
+    //insert
+    pair<iterator,bool> insert(const_reference value)
+    {
+        iterator iter=lower_bound(value);
+        if(iter!=end() && !_comp(value,*iter))
+            return {iter,false};
+        return {_keys.insert(const_cast<key_type*>(iter),value),true};
+    }
+
+    //append,sort and merge once:O(n+m log m) for m new keys.
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        rep_type batch;
+        for(;begin!=end;++begin)
+            batch.push_back(*begin);
+        if(batch.empty()) return;
+
+        sort(batch.begin(),batch.end(),_comp);
+        merge_unique(batch);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        insert(il.begin(),il.end());
+    }
+
+
+    //erase
+    iterator erase(iterator tar) {return _keys.erase(const_cast<key_type*>(tar));}
+
+    size_type erase(const key_type& k)
+    {
+        iterator iter=find(k);
+        if(iter==end()) return 0;
+        erase(iter);
+        return 1;
+    }
+
+    iterator erase(iterator begin,iterator end)
+    {
+        return _keys.erase(const_cast<key_type*>(begin),const_cast<key_type*>(end));
+    }
+
+    void clear() {_keys.clear();}
+
+
+    //unique
+    iterator find(const key_type& k) const
+    {
+        iterator iter=lower_bound(k);
+        return (iter==end() || _comp(k,*iter)) ? end() : iter;
+    }
+
+    size_type count(const key_type& k) const {return find(k)==end() ? 0 : 1;}
+
+    iterator lower_bound(const key_type& k) const {return sstl::lower_bound(begin(),end(),k,_comp);}
+
+    iterator upper_bound(const key_type& k) const {return sstl::upper_bound(begin(),end(),k,_comp);}
+
+    pair<iterator,iterator> equal_range(const key_type& k) const
+    {
+        iterator first=lower_bound(k);
+        iterator last=first;
+        if(last!=end() && !_comp(k,*last))
+            ++last;
+        return {first,last};
+    }
+
+
+    //extra
+    key_compare key_comp() const {return _comp;}
+
+    value_compare value_comp() const {return _comp;}
+
+    ~flat_set(){}
+
+
+private:
+
+    rep_type _keys;
+    key_compare _comp;
+
+
+    //merge the sorted batch into _keys,existing keys win and duplicates are dropped.
+    void merge_unique(rep_type& batch)
+    {
+        rep_type result;
+        result.reserve(_keys.size()+batch.size());
+
+        //both inputs are thrown away afterwards,so their keys are moved
+        key_type* first1=_keys.begin();
+        key_type* last1=_keys.end();
+        key_type* first2=batch.begin();
+        key_type* last2=batch.end();
+        while(first1!=last1 && first2!=last2){
+            if(_comp(*first2,*first1)){
+                result.push_back(std::move(*skip_equal(first2,last2)));
+            }else{
+                if(!_comp(*first1,*first2))
+                    skip_equal(first2,last2);
+                result.push_back(std::move(*first1++));
+            }
+        }
+        for(;first1!=last1;++first1)
+            result.push_back(std::move(*first1));
+        while(first2!=last2)
+            result.push_back(std::move(*skip_equal(first2,last2)));
+        _keys.swap(result);
+    }
+
+    //advance past the run of keys equal to *first,return the first of the run
+    key_type* skip_equal(key_type*& first,key_type* last) const
+    {
+        key_type* run=first;
+        while(++first!=last && !_comp(*run,*first))
+            ;
+        return run;
+    }
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // FLAT_SET_H_INCLUDED
@@ -24,7 +24,7 @@ struct binary_function
 
 
 //arithmetic functions
-template <class T>
+template <class T=void>
 struct plus : public binary_function<T,T,T>
 {
     T operator()(const T& x,const T& y) const {return x+y;}
@@ -38,13 +38,33 @@ struct minus : public binary_function<T,T,T>
 };
 
 
-template <class T>
+template <class T=void>
 struct multiplies : public binary_function<T,T,T>
 {
     T operator()(const T& x,const T& y) const {return x*y;}
 };
 
 
+//plus<>,multiplies<>:the operator on the argument types,like accumulate's sum+*iter
+template <>
+struct plus<void>
+{
+    typedef void is_transparent;
+
+    template <class T,class U>
+    auto operator()(const T& x,const U& y) const -> decltype(x+y) {return x+y;}
+};
+
+template <>
+struct multiplies<void>
+{
+    typedef void is_transparent;
+
+    template <class T,class U>
+    auto operator()(const T& x,const U& y) const -> decltype(x*y) {return x*y;}
+};
+
+
 template <class T>
 struct divides : public binary_function<T,T,T>
 {
@@ -89,7 +109,7 @@ struct not_equal_to : public binary_function<T,T,bool>
 };
 
 
-template <class T>
+template <class T=void>
 struct greater : public binary_function<T,T,bool>
 {
     bool operator()(const T& x,const T& y) const {return x>y;}
@@ -103,13 +123,34 @@ struct greater_equal : public binary_function<T,T,bool>
 };
 
 
-template <class T>
+template <class T=void>
 struct less : public binary_function<T,T,bool>
 {
     bool operator()(const T& x,const T& y) const {return x<y;}
 };
 
 
+//transparent comparators(less<>,greater<>):compare mixed types directly,
+//so set<std::string,less<>>::find("abc") builds no temporary key.
+template <>
+struct less<void>
+{
+    typedef void is_transparent;
+
+    template <class T,class U>
+    bool operator()(const T& x,const U& y) const {return x<y;}
+};
+
+template <>
+struct greater<void>
+{
+    typedef void is_transparent;
+
+    template <class T,class U>
+    bool operator()(const T& x,const U& y) const {return x>y;}
+};
+
+
 template <class T>
 struct less_equal : public binary_function<T,T,bool>
 {
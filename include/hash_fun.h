@@ -0,0 +1,141 @@
+#ifndef HASH_FUN_H_INCLUDED
+#define HASH_FUN_H_INCLUDED
+
+#include "sstl.h"
+
+#include <string>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//hash functors
+//integers hash to themselves,hash tables are expected to mix the bits.
+template <class Key>
+struct hash{};
+
+
+//FNV-1a
+inline size_t hash_bytes(const char* s,size_t n)
+{
+    unsigned long long h=14695981039346656037ULL;
+    for(size_t i=0;i<n;++i){
+        h^=static_cast<unsigned char>(s[i]);
+        h*=1099511628211ULL;
+    }
+    return static_cast<size_t>(h);
+}
+
+inline size_t hash_string(const char* s)
+{
+    unsigned long long h=14695981039346656037ULL;
+    for(;*s;++s){
+        h^=static_cast<unsigned char>(*s);
+        h*=1099511628211ULL;
+    }
+    return static_cast<size_t>(h);
+}
+
+
+template <>
+struct hash<char*>
+{
+    size_t operator()(const char* s) const {return hash_string(s);}
+};
+
+template <>
+struct hash<const char*>
+{
+    size_t operator()(const char* s) const {return hash_string(s);}
+};
+
+template <>
+struct hash<std::string>
+{
+    size_t operator()(const std::string& s) const {return hash_bytes(s.data(),s.size());}
+};
+
+
+template <>
+struct hash<char>
+{
+    size_t operator()(char x) const {return x;}
+};
+
+template <>
+struct hash<unsigned char>
+{
+    size_t operator()(unsigned char x) const {return x;}
+};
+
+template <>
+struct hash<signed char>
+{
+    size_t operator()(signed char x) const {return x;}
+};
+
+template <>
+struct hash<short>
+{
+    size_t operator()(short x) const {return x;}
+};
+
+template <>
+struct hash<unsigned short>
+{
+    size_t operator()(unsigned short x) const {return x;}
+};
+
+template <>
+struct hash<int>
+{
+    size_t operator()(int x) const {return x;}
+};
+
+template <>
+struct hash<unsigned int>
+{
+    size_t operator()(unsigned int x) const {return x;}
+};
+
+template <>
+struct hash<long>
+{
+    size_t operator()(long x) const {return x;}
+};
+
+template <>
+struct hash<unsigned long>
+{
+    size_t operator()(unsigned long x) const {return x;}
+};
+
+template <>
+struct hash<long long>
+{
+    size_t operator()(long long x) const {return x;}
+};
+
+template <>
+struct hash<unsigned long long>
+{
+    size_t operator()(unsigned long long x) const {return x;}
+};
+
+
+//spread the bits of a hash value(murmur3 finalizer)
+inline size_t hash_mix(size_t h)
+{
+    unsigned long long x=h;
+    x^=x >> 33;
+    x*=0xff51afd7ed558ccdULL;
+    x^=x >> 33;
+    x*=0xc4ceb9fe1a85ec53ULL;
+    x^=x >> 33;
+    return static_cast<size_t>(x);
+}
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // HASH_FUN_H_INCLUDED
@@ -0,0 +1,274 @@
+#ifndef HASH_MAP_H_INCLUDED
+#define HASH_MAP_H_INCLUDED
+
+#include "hashtable.h"
+
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//element addresses are stable,rehashing is spread over inserts(see hashtable.h).
+template <class Key,class Value,class Hash=hash<Key>,class KeyEqual=equal_to<Key>,class Alloc=malloc_alloc>
+class hash_map
+{
+public:
+
+    //typedefs
+    typedef Key                         key_type;
+    typedef Value                       data_type;
+    typedef Value                       mapped_type;
+    typedef pair<key_type,data_type>    value_type;
+    typedef Hash                        hasher;
+    typedef KeyEqual                    key_equal;
+
+    typedef hashtable<key_type,value_type,select1st<value_type>,hasher,key_equal,Alloc> rep_type;
+
+    typedef typename rep_type::iterator         iterator;
+    typedef typename rep_type::const_iterator   const_iterator;
+    typedef typename rep_type::pointer          pointer;
+    typedef typename rep_type::const_pointer    const_pointer;
+    typedef typename rep_type::reference        reference;
+    typedef typename rep_type::const_reference  const_reference;
+    typedef typename rep_type::size_type        size_type;
+    typedef typename rep_type::difference_type  difference_type;
+
+
+    //constructors
+    hash_map():t(){}
+
+    explicit hash_map(size_type n,const hasher& hf=hasher(),const key_equal& eq=key_equal()):t(n,hf,eq){}
+
+    template <class InputIterator>
+    hash_map(InputIterator begin,InputIterator end):t()
+    {
+        t.insert_unique(begin,end);
+    }
+
+    hash_map(std::initializer_list<value_type> il):t(il.size())
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+    hash_map(const hash_map& m):t(m.t){}
+
+
+    //assignment
+    hash_map& operator=(const hash_map& m) {t=m.t;return *this;}
+
+
+    //iterators
+    iterator begin() const {return t.begin();}
+
+    iterator end() const {return t.end();}
+
+    const_iterator cbegin() const {return t.cbegin();}
+
+    const_iterator cend() const {return t.cend();}
+
+
+    //swap
+    void swap(hash_map& m) {t.swap(m.t);}
+
+
+    //size
+    bool empty() const {return t.empty();}
+
+    size_type size() const {return t.size();}
+
+    size_type bucket_count() const {return t.bucket_count();}
+
+    float load_factor() const {return t.load_factor();}
+
+    void reserve(size_type n) {t.reserve(n);}
+
+    void rehash(size_type n) {t.rehash(n);}
+
+
+    //data access
+    data_type& operator[](const key_type& k)
+    {
+        return t.emplace_unique_key(k,in_place_second,k).first->second;
+    }
+
+
+    //insert
+    pair<iterator,bool> insert(const_reference value)
+    {
+        return t.insert_unique(value);
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        t.insert_unique(begin,end);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+
+    //erase
+    iterator erase(iterator tar) {return t.erase(tar);}
+
+    size_type erase(const key_type& k) {return t.erase(k);}
+
+    iterator erase(iterator begin,iterator end) {return t.erase(begin,end);}
+
+    void clear() {t.clear();}
+
+
+    //find and count
+    iterator find(const key_type& k) const {return t.find(k);}
+
+    size_type count(const key_type& k) const {return t.count(k);}
+
+    pair<iterator,iterator> equal_range(const key_type& k) const {return t.equal_range(k);}
+
+
+    //extra
+    hasher hash_funct() const {return t.hash_funct();}
+
+    key_equal key_eq() const {return t.key_eq();}
+
+    ~hash_map(){}
+
+private:
+
+    rep_type t;
+
+};
+
+
+template <class Key,class Value,class Hash=hash<Key>,class KeyEqual=equal_to<Key>,class Alloc=malloc_alloc>
+class hash_multimap
+{
+public:
+
+    //typedefs
+    typedef Key                         key_type;
+    typedef Value                       data_type;
+    typedef Value                       mapped_type;
+    typedef pair<key_type,data_type>    value_type;
+    typedef Hash                        hasher;
+    typedef KeyEqual                    key_equal;
+
+    typedef hashtable<key_type,value_type,select1st<value_type>,hasher,key_equal,Alloc> rep_type;
+
+    typedef typename rep_type::iterator         iterator;
+    typedef typename rep_type::const_iterator   const_iterator;
+    typedef typename rep_type::pointer          pointer;
+    typedef typename rep_type::const_pointer    const_pointer;
+    typedef typename rep_type::reference        reference;
+    typedef typename rep_type::const_reference  const_reference;
+    typedef typename rep_type::size_type        size_type;
+    typedef typename rep_type::difference_type  difference_type;
+
+
+    //constructors
+    hash_multimap():t(){}
+
+    explicit hash_multimap(size_type n,const hasher& hf=hasher(),const key_equal& eq=key_equal()):t(n,hf,eq){}
+
+    template <class InputIterator>
+    hash_multimap(InputIterator begin,InputIterator end):t()
+    {
+        t.insert_equal(begin,end);
+    }
+
+    hash_multimap(std::initializer_list<value_type> il):t(il.size())
+    {
+        t.insert_equal(il.begin(),il.end());
+    }
+
+    hash_multimap(const hash_multimap& m):t(m.t){}
+
+
+    //assignment
+    hash_multimap& operator=(const hash_multimap& m) {t=m.t;return *this;}
+
+
+    //iterators
+    iterator begin() const {return t.begin();}
+
+    iterator end() const {return t.end();}
+
+    const_iterator cbegin() const {return t.cbegin();}
+
+    const_iterator cend() const {return t.cend();}
+
+
+    //swap
+    void swap(hash_multimap& m) {t.swap(m.t);}
+
+
+    //size
+    bool empty() const {return t.empty();}
+
+    size_type size() const {return t.size();}
+
+    size_type bucket_count() const {return t.bucket_count();}
+
+    float load_factor() const {return t.load_factor();}
+
+    void reserve(size_type n) {t.reserve(n);}
+
+    void rehash(size_type n) {t.rehash(n);}
+
+
+    //insert
+    iterator insert(const_reference value)
+    {
+        return t.insert_equal(value);
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        t.insert_equal(begin,end);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        t.insert_equal(il.begin(),il.end());
+    }
+
+
+    //erase
+    iterator erase(iterator tar) {return t.erase(tar);}
+
+    size_type erase(const key_type& k) {return t.erase(k);}
+
+    iterator erase(iterator begin,iterator end) {return t.erase(begin,end);}
+
+    void clear() {t.clear();}
+
+
+    //find and count
+    iterator find(const key_type& k) const {return t.find(k);}
+
+    size_type count(const key_type& k) const {return t.count(k);}
+
+    pair<iterator,iterator> equal_range(const key_type& k) const {return t.equal_range(k);}
+
+
+    //extra
+    hasher hash_funct() const {return t.hash_funct();}
+
+    key_equal key_eq() const {return t.key_eq();}
+
+    ~hash_multimap(){}
+
+private:
+
+    rep_type t;
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // HASH_MAP_H_INCLUDED
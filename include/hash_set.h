@@ -0,0 +1,264 @@
+#ifndef HASH_SET_H_INCLUDED
+#define HASH_SET_H_INCLUDED
+
+#include "hashtable.h"
+
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//element addresses are stable,rehashing is spread over inserts(see hashtable.h).
+template <class Key,class Hash=hash<Key>,class KeyEqual=equal_to<Key>,class Alloc=malloc_alloc>
+class hash_set
+{
+public:
+
+    //typedefs
+    typedef Key         key_type;
+    typedef Key         value_type;
+    typedef Hash        hasher;
+    typedef KeyEqual    key_equal;
+
+    typedef hashtable<key_type,value_type,identity<value_type>,hasher,key_equal,Alloc> rep_type;
+
+    typedef typename rep_type::const_iterator   iterator;
+    typedef typename rep_type::const_iterator   const_iterator;
+    typedef typename rep_type::const_pointer    pointer;
+    typedef typename rep_type::const_pointer    const_pointer;
+    typedef typename rep_type::const_reference  reference;
+    typedef typename rep_type::const_reference  const_reference;
+    typedef typename rep_type::size_type        size_type;
+    typedef typename rep_type::difference_type  difference_type;
+
+
+    //constructors
+    hash_set():t(){}
+
+    explicit hash_set(size_type n,const hasher& hf=hasher(),const key_equal& eq=key_equal()):t(n,hf,eq){}
+
+    template <class InputIterator>
+    hash_set(InputIterator begin,InputIterator end):t()
+    {
+        t.insert_unique(begin,end);
+    }
+
+    hash_set(std::initializer_list<key_type> il):t(il.size())
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+    hash_set(const hash_set& s):t(s.t){}
+
+
+    //assignment
+    hash_set& operator=(const hash_set& s) {t=s.t;return *this;}
+
+
+    //iterators
+    iterator begin() const {return t.cbegin();}
+
+    iterator end() const {return t.cend();}
+
+
+    //swap
+    void swap(hash_set& s) {t.swap(s.t);}
+
+
+    //size
+    bool empty() const {return t.empty();}
+
+    size_type size() const {return t.size();}
+
+    size_type bucket_count() const {return t.bucket_count();}
+
+    float load_factor() const {return t.load_factor();}
+
+    void reserve(size_type n) {t.reserve(n);}
+
+    void rehash(size_type n) {t.rehash(n);}
+
+
+    //insert
+    pair<iterator,bool> insert(const_reference value)
+    {
+        pair<typename rep_type::iterator,bool> ret=t.insert_unique(value);
+        return {iterator(ret.first),ret.second};
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        t.insert_unique(begin,end);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+
+    //erase
+    iterator erase(iterator tar) {return iterator(t.erase(tar.base()));}
+
+    size_type erase(const key_type& k) {return t.erase(k);}
+
+    iterator erase(iterator begin,iterator end) {return iterator(t.erase(begin.base(),end.base()));}
+
+    void clear() {t.clear();}
+
+
+    //find and count
+    iterator find(const key_type& k) const {return iterator(t.find(k));}
+
+    size_type count(const key_type& k) const {return t.count(k);}
+
+    pair<iterator,iterator> equal_range(const key_type& k) const
+    {
+        pair<typename rep_type::iterator,typename rep_type::iterator> ret=t.equal_range(k);
+        return {iterator(ret.first),iterator(ret.second)};
+    }
+
+
+    //extra
+    hasher hash_funct() const {return t.hash_funct();}
+
+    key_equal key_eq() const {return t.key_eq();}
+
+    ~hash_set(){}
+
+private:
+
+    rep_type t;
+
+};
+
+
+template <class Key,class Hash=hash<Key>,class KeyEqual=equal_to<Key>,class Alloc=malloc_alloc>
+class hash_multiset
+{
+public:
+
+    //typedefs
+    typedef Key         key_type;
+    typedef Key         value_type;
+    typedef Hash        hasher;
+    typedef KeyEqual    key_equal;
+
+    typedef hashtable<key_type,value_type,identity<value_type>,hasher,key_equal,Alloc> rep_type;
+
+    typedef typename rep_type::const_iterator   iterator;
+    typedef typename rep_type::const_iterator   const_iterator;
+    typedef typename rep_type::const_pointer    pointer;
+    typedef typename rep_type::const_pointer    const_pointer;
+    typedef typename rep_type::const_reference  reference;
+    typedef typename rep_type::const_reference  const_reference;
+    typedef typename rep_type::size_type        size_type;
+    typedef typename rep_type::difference_type  difference_type;
+
+
+    //constructors
+    hash_multiset():t(){}
+
+    explicit hash_multiset(size_type n,const hasher& hf=hasher(),const key_equal& eq=key_equal()):t(n,hf,eq){}
+
+    template <class InputIterator>
+    hash_multiset(InputIterator begin,InputIterator end):t()
+    {
+        t.insert_equal(begin,end);
+    }
+
+    hash_multiset(std::initializer_list<key_type> il):t(il.size())
+    {
+        t.insert_equal(il.begin(),il.end());
+    }
+
+    hash_multiset(const hash_multiset& s):t(s.t){}
+
+
+    //assignment
+    hash_multiset& operator=(const hash_multiset& s) {t=s.t;return *this;}
+
+
+    //iterators
+    iterator begin() const {return t.cbegin();}
+
+    iterator end() const {return t.cend();}
+
+
+    //swap
+    void swap(hash_multiset& s) {t.swap(s.t);}
+
+
+    //size
+    bool empty() const {return t.empty();}
+
+    size_type size() const {return t.size();}
+
+    size_type bucket_count() const {return t.bucket_count();}
+
+    float load_factor() const {return t.load_factor();}
+
+    void reserve(size_type n) {t.reserve(n);}
+
+    void rehash(size_type n) {t.rehash(n);}
+
+
+    //insert
+    iterator insert(const_reference value)
+    {
+        return iterator(t.insert_equal(value));
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        t.insert_equal(begin,end);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        t.insert_equal(il.begin(),il.end());
+    }
+
+
+    //erase
+    iterator erase(iterator tar) {return iterator(t.erase(tar.base()));}
+
+    size_type erase(const key_type& k) {return t.erase(k);}
+
+    iterator erase(iterator begin,iterator end) {return iterator(t.erase(begin.base(),end.base()));}
+
+    void clear() {t.clear();}
+
+
+    //find and count
+    iterator find(const key_type& k) const {return iterator(t.find(k));}
+
+    size_type count(const key_type& k) const {return t.count(k);}
+
+    pair<iterator,iterator> equal_range(const key_type& k) const
+    {
+        pair<typename rep_type::iterator,typename rep_type::iterator> ret=t.equal_range(k);
+        return {iterator(ret.first),iterator(ret.second)};
+    }
+
+
+    //extra
+    hasher hash_funct() const {return t.hash_funct();}
+
+    key_equal key_eq() const {return t.key_eq();}
+
+    ~hash_multiset(){}
+
+private:
+
+    rep_type t;
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // HASH_SET_H_INCLUDED
@@ -0,0 +1,542 @@
+#ifndef HASHTABLE_H_INCLUDED
+#define HASHTABLE_H_INCLUDED
+
+#include "sstl.h"
+#include "allocator.h"
+#include "iterator_traits.h"
+#include "iterator.h"
+#include "function.h"
+#include "utilities.h"
+#include "algorithm.h"
+#include "vector.h"
+#include "hash_fun.h"
+
+
+SSTL_NAMESPACE_BEGIN
+
+//bucket counts are primes(as in SGI),so identity hashes of integers spread well.
+constexpr int hashtable_num_primes=28;
+
+static const unsigned long hashtable_prime_list[hashtable_num_primes]=
+{
+    53ul,         97ul,         193ul,       389ul,       769ul,
+    1543ul,       3079ul,       6151ul,      12289ul,     24593ul,
+    49157ul,      98317ul,      196613ul,    393241ul,    786433ul,
+    1572869ul,    3145739ul,    6291469ul,   12582917ul,  25165843ul,
+    50331653ul,   100663319ul,  201326611ul, 402653189ul, 805306457ul,
+    1610612741ul, 3221225473ul, 4294967291ul
+};
+
+inline unsigned long hashtable_next_prime(unsigned long n)
+{
+    const unsigned long* first=hashtable_prime_list;
+    const unsigned long* last=hashtable_prime_list+hashtable_num_primes;
+    const unsigned long* pos=sstl::lower_bound(first,last,n);
+    return pos==last ? *(last-1) : *pos;
+}
+
+
+//chained node,the hash is kept so rehashing never calls the hash function again.
+template <class T>
+struct hashtable_node
+{
+    hashtable_node* next;
+    size_t hash;
+    T value;
+};
+
+
+template <class Key,class Value,class KeyOfValue,class Hash,class KeyEqual,class Alloc>
+class hashtable;
+
+
+//the iterator remembers its bucket,buckets of the old table come first.
+template <class Key,class Value,class KeyOfValue,class Hash,class KeyEqual,class Alloc>
+struct hashtable_iterator
+{
+    //typedefs
+    typedef forward_iterator_tag    iterator_category;
+    typedef Value                   value_type;
+    typedef Value&                  reference;
+    typedef Value*                  pointer;
+    typedef ptrdiff_t               difference_type;
+    typedef size_t                  size_type;
+
+    typedef hashtable_iterator                                      iterator;
+    typedef hashtable<Key,Value,KeyOfValue,Hash,KeyEqual,Alloc>     table_type;
+    typedef hashtable_node<Value>*                                  link_type;
+
+
+    //wrapped pointers
+    link_type _node;
+    const table_type* _ht;
+    size_type _bucket;
+
+
+    //constructors
+    hashtable_iterator()=default;
+
+    hashtable_iterator(link_type node,const table_type* ht,size_type bucket):_node(node),_ht(ht),_bucket(bucket){}
+
+
+    //data access
+    reference operator*() const {return _node->value;}
+
+    pointer operator->() const {return &(operator*());}
+
+
+    //arithmetic operations
+    iterator& operator++()
+    {
+        _node=_node->next;
+        if(!_node){
+            size_type n=_ht->total_buckets();
+            while(!_node && ++_bucket<n)
+                _node=_ht->bucket_head(_bucket);
+        }
+        return *this;
+    }
+
+    iterator operator++(int)
+    {
+        iterator tmp=*this;
+        ++*this;
+        return tmp;
+    }
+
+
+    //relational operations
+    bool operator==(const iterator& iter) const {return _node==iter._node;}
+
+    bool operator!=(const iterator& iter) const {return _node!=iter._node;}
+
+};
+
+
+//separate chaining hashtable(SGI layout),node addresses never change.
+//growing is incremental:the new bucket array is allocated at once,but the old
+//chains are moved over a few buckets per insert,lookups check both tables meanwhile.
+//insert may invalidate iterators(never pointers or references),erase does not.
+template <class Key,class Value,class KeyOfValue,class Hash=hash<Key>,
+          class KeyEqual=equal_to<Key>,class Alloc=malloc_alloc>
+class hashtable
+{
+    friend struct hashtable_iterator<Key,Value,KeyOfValue,Hash,KeyEqual,Alloc>;
+
+public:
+
+    //typedefs
+    typedef Key         key_type;
+    typedef Value       value_type;
+    typedef Hash        hasher;
+    typedef KeyEqual    key_equal;
+
+    typedef hashtable_iterator<Key,Value,KeyOfValue,Hash,KeyEqual,Alloc>    iterator;
+    typedef sstl::const_iterator<iterator>                                  const_iterator;
+    typedef size_t                                                          size_type;
+    typedef value_type*                                                     pointer;
+    typedef const value_type*                                               const_pointer;
+    typedef value_type&                                                     reference;
+    typedef const value_type&                                               const_reference;
+    typedef ptrdiff_t                                                       difference_type;
+
+    //old buckets moved per insert while rehashing
+    static constexpr size_type rehash_step=4;
+
+
+    //constructors
+    explicit hashtable(size_type n=0,const hasher& hf=hasher(),const key_equal& eq=key_equal())
+        :_buckets(hashtable_next_prime(n),nullptr),_migrate(0),_size(0),_hash(hf),_eq(eq){}
+
+    hashtable(const hashtable& ht)
+        :_buckets(ht._buckets.size(),nullptr),_migrate(0),_size(0),_hash(ht._hash),_eq(ht._eq)
+    {
+        copy_from(ht);
+    }
+
+
+    //assignment
+    hashtable& operator=(const hashtable& ht)
+    {
+        if(this==&ht) return *this;
+        clear();
+        release_old();
+        _hash=ht._hash;
+        _eq=ht._eq;
+        if(_buckets.size()!=ht._buckets.size())
+            vector<link_type,Alloc>(ht._buckets.size(),nullptr).swap(_buckets);
+        copy_from(ht);
+        return *this;
+    }
+
+
+    //swap
+    void swap(hashtable& ht)
+    {
+        _buckets.swap(ht._buckets);
+        _old.swap(ht._old);
+        size_type tmp_migrate=_migrate;_migrate=ht._migrate;ht._migrate=tmp_migrate;
+        size_type tmp_size=_size;_size=ht._size;ht._size=tmp_size;
+        hasher tmp_hash=_hash;_hash=ht._hash;ht._hash=tmp_hash;
+        key_equal tmp_eq=_eq;_eq=ht._eq;ht._eq=tmp_eq;
+    }
+
+
+    //iterators
+    iterator begin() const
+    {
+        size_type n=total_buckets();
+        for(size_type i=0;i<n;++i)
+            if(link_type p=bucket_head(i))
+                return iterator(p,this,i);
+        return end();
+    }
+
+    iterator end() const {return iterator(nullptr,this,total_buckets());}
+
+    const_iterator cbegin() const {return const_iterator(begin());}
+
+    const_iterator cend() const {return const_iterator(end());}
+
+
+    //size
+    bool empty() const {return _size==0;}
+
+    size_type size() const {return _size;}
+
+    size_type bucket_count() const {return _buckets.size();}
+
+    float load_factor() const {return float(_size)/_buckets.size();}
+
+    bool rehashing() const {return !_old.empty();}
+
+    hasher hash_funct() const {return _hash;}
+
+    key_equal key_eq() const {return _eq;}
+
+
+    //capacity
+    //grow to hold n elements at load factor 1,any pending rehash is finished first.
+    void reserve(size_type n)
+    {
+        finish_rehash();
+        if(n>_buckets.size())
+            start_rehash(hashtable_next_prime(n));
+        finish_rehash();
+    }
+
+    void rehash(size_type n) {reserve(n);}
+
+
+    //insert
+    pair<iterator,bool> insert_unique(const_reference value)
+    {
+        return emplace_unique_key(KeyOfValue()(value),value);
+    }
+
+    //k is the key the value built from args will have,nothing is constructed if it is present.
+    template <class... Args>
+    pair<iterator,bool> emplace_unique_key(const key_type& k,Args&&... args)
+    {
+        grow_step();
+        size_t h=_hash(k);
+        iterator iter=find_hashed(k,h);
+        if(iter._node) return {iter,false};
+        return {insert_new(h,std::forward<Args>(args)...),true};
+    }
+
+    iterator insert_equal(const_reference value)
+    {
+        grow_step();
+        const key_type& k=KeyOfValue()(value);
+        size_t h=_hash(k);
+        iterator iter=find_hashed(k,h);
+        if(!iter._node) return insert_new(h,value);
+
+        //keep equal keys adjacent
+        link_type p=create_node(h,value);
+        p->next=iter._node->next;
+        iter._node->next=p;
+        ++_size;
+        return iterator(p,this,iter._bucket);
+    }
+
+    template <class InputIterator>
+    void insert_unique(InputIterator begin,InputIterator end)
+    {
+        for(;begin!=end;++begin)
+            insert_unique(*begin);
+    }
+
+    template <class InputIterator>
+    void insert_equal(InputIterator begin,InputIterator end)
+    {
+        for(;begin!=end;++begin)
+            insert_equal(*begin);
+    }
+
+
+    //erase
+    iterator erase(iterator tar)
+    {
+        iterator next=tar;
+        ++next;
+        link_type* link=bucket_ref(tar._bucket);
+        while(*link!=tar._node)
+            link=&(*link)->next;
+        *link=tar._node->next;
+        destroy_node(tar._node);
+        --_size;
+        return next;
+    }
+
+    size_type erase(const key_type& k)
+    {
+        size_t h=_hash(k);
+        size_type bucket=locate(k,h);
+        link_type* link=bucket_ref(bucket);
+        while(*link && !equals(*link,k,h))
+            link=&(*link)->next;
+
+        size_type n=0;
+        while(*link && equals(*link,k,h)){
+            link_type p=*link;
+            *link=p->next;
+            destroy_node(p);
+            ++n;
+        }
+        _size-=n;
+        return n;
+    }
+
+    iterator erase(iterator begin,iterator end)
+    {
+        while(begin!=end)
+            begin=erase(begin);
+        return end;
+    }
+
+    //keeps the bucket array
+    void clear()
+    {
+        size_type n=total_buckets();
+        for(size_type i=0;i<n;++i){
+            link_type* link=bucket_ref(i);
+            link_type p=*link;
+            while(p){
+                link_type next=p->next;
+                destroy_node(p);
+                p=next;
+            }
+            *link=nullptr;
+        }
+        release_old();
+        _size=0;
+    }
+
+
+    //find and count
+    iterator find(const key_type& k) const
+    {
+        iterator iter=find_hashed(k,_hash(k));
+        return iter._node ? iter : end();
+    }
+
+    size_type count(const key_type& k) const
+    {
+        size_t h=_hash(k);
+        iterator iter=find_hashed(k,h);
+        size_type n=0;
+        for(link_type p=iter._node;p && equals(p,k,h);p=p->next)
+            ++n;
+        return n;
+    }
+
+    pair<iterator,iterator> equal_range(const key_type& k) const
+    {
+        size_t h=_hash(k);
+        iterator first=find_hashed(k,h);
+        if(!first._node) return {end(),end()};
+
+        iterator last=first;
+        while(last._node->next && equals(last._node->next,k,h))
+            ++last;
+        ++last;
+        return {first,last};
+    }
+
+
+    //destructor
+    ~hashtable() {clear();}
+
+private:
+    typedef hashtable_node<value_type>*         link_type;
+    typedef simple_alloc<hashtable_node<value_type>,Alloc>  node_allocator;
+
+    vector<link_type,Alloc> _buckets;
+    vector<link_type,Alloc> _old;       //table being drained,empty if not rehashing
+    size_type _migrate;                 //old buckets below this one are already moved
+    size_type _size;
+    hasher _hash;
+    key_equal _eq;
+
+
+    //allocate and deallocate
+    link_type get_node(){return node_allocator::allocate();}
+
+    void put_node(link_type p){node_allocator::deallocate(p);}
+
+
+    //create and destroy
+    template <class... Args>
+    link_type create_node(size_t h,Args&&... args)
+    {
+        link_type p=get_node();
+        new (&p->value) value_type(std::forward<Args>(args)...);
+        p->hash=h;
+        p->next=nullptr;
+        return p;
+    }
+
+    void destroy_node(link_type p)
+    {
+        destroy(&p->value);
+        put_node(p);
+    }
+
+
+    //buckets,as numbered by the iterator:old table first,then the new one
+    size_type total_buckets() const {return _old.size()+_buckets.size();}
+
+    link_type bucket_head(size_type i) const
+    {
+        return i<_old.size() ? _old.begin()[i] : _buckets.begin()[i-_old.size()];
+    }
+
+    link_type* bucket_ref(size_type i)
+    {
+        return i<_old.size() ? _old.begin()+i : _buckets.begin()+(i-_old.size());
+    }
+
+
+    bool equals(link_type p,const key_type& k,size_t h) const
+    {
+        return p->hash==h && _eq(KeyOfValue()(p->value),k);
+    }
+
+    //the bucket holding k:its old bucket if not moved yet,otherwise its new bucket.
+    //equal keys always live in the same chain.
+    size_type locate(const key_type& k,size_t h) const
+    {
+        if(rehashing()){
+            size_type i=h%_old.size();
+            if(i>=_migrate)
+                for(link_type p=_old.begin()[i];p;p=p->next)
+                    if(equals(p,k,h))
+                        return i;
+        }
+        return _old.size()+h%_buckets.size();
+    }
+
+    //first node equal to k,or a null iterator
+    iterator find_hashed(const key_type& k,size_t h) const
+    {
+        size_type bucket=locate(k,h);
+        link_type p=bucket_head(bucket);
+        while(p && !equals(p,k,h))
+            p=p->next;
+        return iterator(p,this,bucket);
+    }
+
+    //push a node built from args at the head of its new bucket
+    template <class... Args>
+    iterator insert_new(size_t h,Args&&... args)
+    {
+        size_type i=h%_buckets.size();
+        link_type p=create_node(h,std::forward<Args>(args)...);
+        p->next=_buckets.begin()[i];
+        _buckets.begin()[i]=p;
+        ++_size;
+        return iterator(p,this,_old.size()+i);
+    }
+
+
+    //rehash
+    //called before every insert:move a few old buckets,start growing at load factor 1.
+    void grow_step()
+    {
+        if(rehashing())
+            migrate(rehash_step);
+        if(_size+1>_buckets.size()){
+            finish_rehash();
+            size_type n=hashtable_next_prime(_size+1);
+            if(n>_buckets.size())
+                start_rehash(n);
+        }
+    }
+
+    void start_rehash(size_type n)
+    {
+        vector<link_type,Alloc> tmp(n,nullptr);
+        _buckets.swap(tmp);
+        _old.swap(tmp);
+        _migrate=0;
+    }
+
+    void finish_rehash()
+    {
+        if(rehashing())
+            migrate(_old.size());
+    }
+
+    //move up to n old chains into the new table
+    void migrate(size_type n)
+    {
+        link_type* old=_old.begin();
+        link_type* buckets=_buckets.begin();
+        size_type count=_buckets.size();
+        for(;n && _migrate<_old.size();--n,++_migrate){
+            link_type p=old[_migrate];
+            while(p){
+                link_type next=p->next;
+                size_type i=p->hash%count;
+                p->next=buckets[i];
+                buckets[i]=p;
+                p=next;
+            }
+            old[_migrate]=nullptr;
+        }
+        if(_migrate==_old.size())
+            release_old();
+    }
+
+    void release_old()
+    {
+        vector<link_type,Alloc> tmp;
+        _old.swap(tmp);
+        _migrate=0;
+    }
+
+
+    //copy chain by chain into the new buckets,equal keys stay adjacent.
+    void copy_from(const hashtable& ht)
+    {
+        size_type n=ht.total_buckets();
+        size_type count=_buckets.size();
+        for(size_type b=0;b<n;++b)
+            for(link_type q=ht.bucket_head(b);q;q=q->next){
+                size_type i=q->hash%count;
+                link_type p=create_node(q->hash,q->value);
+                p->next=_buckets.begin()[i];
+                _buckets.begin()[i]=p;
+                ++_size;
+            }
+    }
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // HASHTABLE_H_INCLUDED
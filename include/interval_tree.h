@@ -0,0 +1,202 @@
+#ifndef INTERVAL_TREE_H_INCLUDED
+#define INTERVAL_TREE_H_INCLUDED
+
+#include "tree.h"
+
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//max-end augmentation:metadata is the largest high end in the subtree.
+template <class T,class Compare=less<T>>
+struct interval_max_end_update
+{
+    typedef T metadata_type;
+
+    template <class PNode>
+    void operator()(PNode p) const
+    {
+        Compare comp;
+        p->metadata=p->value.second;
+        if(p->left && comp(p->metadata,p->left->metadata))
+            p->metadata=p->left->metadata;
+        if(p->right && comp(p->metadata,p->right->metadata))
+            p->metadata=p->right->metadata;
+    }
+};
+
+
+//closed intervals [low,high],ordered by low.
+template <class T,class Compare=less<T>,class Alloc=malloc_alloc>
+class interval_tree
+{
+public:
+
+    //typedefs
+    typedef T                   key_type;
+    typedef pair<T,T>           value_type;
+    typedef pair<T,T>           interval_type;
+    typedef Compare             key_compare;
+
+    typedef rb_tree<key_type,value_type,select1st<value_type>,key_compare,Alloc,
+                    interval_max_end_update<T,Compare>> rep_type;
+
+    typedef typename rep_type::const_iterator           iterator;
+    typedef typename rep_type::const_iterator           const_iterator;
+    typedef typename rep_type::const_reverse_iterator   reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator   const_reverse_iterator;
+    typedef typename rep_type::const_pointer            pointer;
+    typedef typename rep_type::const_pointer            const_pointer;
+    typedef typename rep_type::const_reference          reference;
+    typedef typename rep_type::const_reference          const_reference;
+    typedef typename rep_type::size_type                size_type;
+    typedef typename rep_type::difference_type          difference_type;
+
+
+    //constructors
+    interval_tree():t(key_compare()){}
+
+    explicit interval_tree(const key_compare& comp):t(comp){}
+
+    template <class InputIterator>
+    interval_tree(InputIterator begin,InputIterator end,const key_compare& comp=key_compare()):t(comp)
+    {
+        t.insert_equal(begin,end);
+    }
+
+    interval_tree(std::initializer_list<value_type> il):t(key_compare())
+    {
+        t.insert_equal(il.begin(),il.end());
+    }
+
+    interval_tree(const interval_tree& it):t(it.t){}
+
+
+    //assignment
+    interval_tree& operator=(const interval_tree& it) {t=it.t;return *this;}
+
+
+    //iterators
+    iterator begin() const {return t.cbegin();}
+
+    iterator end() const {return t.cend();}
+
+    reverse_iterator rbegin() const {return t.crbegin();}
+
+    reverse_iterator rend() const {return t.crend();}
+
+
+    //swap
+    void swap(interval_tree& it) {t.swap(it.t);}
+
+
+    //size
+    bool empty() const {return t.empty();}
+
+    size_type size() const {return t.size();}
+
+
+    //insert
+    iterator insert(const_reference value) {return iterator(t.insert_equal(value));}
+
+    iterator insert(const key_type& low,const key_type& high) {return insert(value_type(low,high));}
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end) {t.insert_equal(begin,end);}
+
+
+    //erase
+    void erase(iterator tar) {t.erase(tar.base());}
+
+    //erase one interval equal to [low,high],return false if there is none.
+    bool erase(const key_type& low,const key_type& high)
+    {
+        iterator iter=find(low,high);
+        if(iter==end()) return false;
+        erase(iter);
+        return true;
+    }
+
+    void clear() {t.clear();}
+
+
+    //find [low,high] exactly
+    iterator find(const key_type& low,const key_type& high) const
+    {
+        key_compare comp=t.key_comp();
+        iterator iter(t.find(low));
+        for(;iter!=end() && !comp(low,iter->first);++iter)
+            if(!comp(iter->second,high) && !comp(high,iter->second))
+                return iter;
+        return end();
+    }
+
+
+    //overlap queries,O(min(n,k log n)) for k results(in order of low end).
+    //intervals containing x
+    template <class OutputIterator>
+    OutputIterator stab(const key_type& x,OutputIterator result) const
+    {
+        return overlaps(x,x,result);
+    }
+
+    //intervals intersecting [low,high]
+    template <class OutputIterator>
+    OutputIterator overlaps(const key_type& low,const key_type& high,OutputIterator result) const
+    {
+        return collect_overlaps(t.root(),low,high,result);
+    }
+
+    //any interval intersecting [low,high],end() if there is none.O(log n).
+    iterator find_overlap(const key_type& low,const key_type& high) const
+    {
+        key_compare comp=t.key_comp();
+        link_type cur=t.root();
+        while(cur){
+            if(!comp(high,cur->value.first) && !comp(cur->value.second,low))
+                return iterator(typename rep_type::iterator(cur));
+            //the left subtree can only hold an overlap if its max end reaches low.
+            if(cur->left && !comp(cur->left->metadata,low))
+                cur=cur->left;
+            else
+                cur=cur->right;
+        }
+        return end();
+    }
+
+
+    //extra
+    key_compare key_comp() const {return t.key_comp();}
+
+    ~interval_tree(){}
+
+private:
+
+    typedef typename rep_type::link_type link_type;
+
+    rep_type t;
+
+
+    template <class OutputIterator>
+    OutputIterator collect_overlaps(link_type p,const key_type& low,const key_type& high,
+                                    OutputIterator result) const
+    {
+        key_compare comp=t.key_comp();
+        if(!p || comp(p->metadata,low)) return result;      //nothing in this subtree reaches low.
+
+        result=collect_overlaps(p->left,low,high,result);
+        if(comp(high,p->value.first)) return result;        //p and its right subtree start after high.
+
+        if(!comp(p->value.second,low))
+            *result++=p->value;
+        return collect_overlaps(p->right,low,high,result);
+    }
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // INTERVAL_TREE_H_INCLUDED
@@ -2,6 +2,7 @@
 #define ITERATOR_H_INCLUDED
 
 #include "sstl.h"
+#include "iterator_traits.h"
 
 SSTL_NAMESPACE_BEGIN
 
@@ -220,6 +221,11 @@ public:
         return reverse_iterator(_current+n);
     }
 
+    difference_type operator-(const reverse_iterator& riter) const
+    {
+        return riter._current-_current;
+    }
+
     reverse_iterator& operator+=(difference_type n)
     {
         _current-=n;
@@ -81,7 +81,7 @@ struct list_iterator
 
 
     //relational operators
-    bool operator==(const iterator& iter) const{return _node=iter._node;}
+    bool operator==(const iterator& iter) const{return _node==iter._node;}
 
     bool operator!=(const iterator& iter) const{return _node!=iter._node;}
 
@@ -5,7 +5,7 @@
 
 SSTL_NAMESPACE_BEGIN
 
-template <class Key,class Value,class Compare=less<Key>,class Alloc=malloc_alloc>
+template <class Key,class Value,class Compare=less<Key>,class Alloc=malloc_alloc,class NodeUpdate=rb_tree_null_update>
 class map
 {
 public:
@@ -32,7 +32,7 @@ public:
 
     };
 
-    typedef rb_tree<key_type,value_type,select1st<value_type>,key_compare,Alloc> rep_type;
+    typedef rb_tree<key_type,value_type,select1st<value_type>,key_compare,Alloc,NodeUpdate> rep_type;
 
     typedef typename rep_type::iterator                 iterator;
     typedef typename rep_type::const_iterator           const_iterator;
@@ -98,9 +98,10 @@ public:
 
 
     //data access
+    //the value is only constructed(value-initialized) if k is absent
     data_type& operator[](const key_type& k)
     {
-        return (*(insert(value_type(k,data_type())).first)).second;
+        return t.emplace_unique_key(k,in_place_second,k).first->second;
     }
 
 
@@ -121,6 +122,30 @@ public:
         t.insert_unique(il.begin(),il.end());
     }
 
+    //build the value in place from args,nothing is constructed if k is present
+    template <class... Args>
+    pair<iterator,bool> try_emplace(const key_type& k,Args&&... args)
+    {
+        return t.emplace_unique_key(k,in_place_second,k,std::forward<Args>(args)...);
+    }
+
+    //insert(k,obj),or assign obj to the value of k
+    template <class M>
+    pair<iterator,bool> insert_or_assign(const key_type& k,M&& obj)
+    {
+        pair<iterator,bool> ret=t.emplace_unique_key(k,in_place_second,k,std::forward<M>(obj));
+        if(!ret.second)
+            ret.first->second=std::forward<M>(obj);
+        return ret;
+    }
+
+    //construct a value_type from args,it is dropped if its key is present
+    template <class... Args>
+    pair<iterator,bool> emplace(Args&&... args)
+    {
+        return t.emplace_unique(std::forward<Args>(args)...);
+    }
+
     void erase(iterator tar) {t.erase(tar);}
 
     void erase(const key_type& k) {t.erase(k);}
@@ -142,6 +167,45 @@ public:
     pair<iterator,iterator> equal_range(const key_type& k) const {return t.equal_range(k);}
 
 
+    //heterogeneous lookup,only with a transparent comparator(less<>)
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator find(const K& k) const {return t.find(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    size_type count(const K& k) const {return t.count(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator lower_bound(const K& k) const {return t.lower_bound(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator upper_bound(const K& k) const {return t.upper_bound(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    pair<iterator,iterator> equal_range(const K& k) const {return t.equal_range(k);}
+
+
+    //order statistics(NodeUpdate must be rb_tree_order_statistics_update)
+    iterator nth(size_type k) const {return t.nth(k);}
+
+    size_type rank(const key_type& k) const {return t.rank(k);}
+
+    difference_type distance(iterator begin,iterator end) const {return t.distance(begin,end);}
+
+
+    //parallel traversal(needs parallel_tree.h),f is called concurrently
+    template <class Function>
+    void parallel_for_each(Function f,size_type threads=0) {rb_tree_parallel<rep_type>::for_each(t,f,threads);}
+
+    template <class Function>
+    void parallel_for_each(Function f,size_type threads=0) const {rb_tree_parallel<rep_type>::for_each(t,f,threads);}
+
+    template <class T,class BinaryOp,class Transform>
+    T parallel_reduce(T init,BinaryOp op,Transform tr,size_type threads=0) const
+    {
+        return rb_tree_parallel<rep_type>::reduce(t,init,op,tr,threads);
+    }
+
+
     //destructor
     ~map(){}
 
@@ -152,7 +216,7 @@ private:
 
 
 
-template <class Key,class Value,class Compare=less<Key>,class Alloc=malloc_alloc>
+template <class Key,class Value,class Compare=less<Key>,class Alloc=malloc_alloc,class NodeUpdate=rb_tree_null_update>
 class multimap
 {
 public:
@@ -179,7 +243,7 @@ public:
 
     };
 
-    typedef rb_tree<key_type,value_type,select1st<value_type>,key_compare,Alloc> rep_type;
+    typedef rb_tree<key_type,value_type,select1st<value_type>,key_compare,Alloc,NodeUpdate> rep_type;
 
     typedef typename rep_type::iterator                 iterator;
     typedef typename rep_type::const_iterator           const_iterator;
@@ -261,6 +325,12 @@ public:
         t.insert_equal(il.begin(),il.end());
     }
 
+    template <class... Args>
+    iterator emplace(Args&&... args)
+    {
+        return t.emplace_equal(std::forward<Args>(args)...);
+    }
+
     void erase(iterator tar) {t.erase(tar);}
 
     void erase(const key_type& k) {t.erase(k);}
@@ -282,6 +352,45 @@ public:
     pair<iterator,iterator> equal_range(const key_type& k) const {return t.equal_range(k);}
 
 
+    //heterogeneous lookup,only with a transparent comparator(less<>)
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator find(const K& k) const {return t.find(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    size_type count(const K& k) const {return t.count(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator lower_bound(const K& k) const {return t.lower_bound(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator upper_bound(const K& k) const {return t.upper_bound(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    pair<iterator,iterator> equal_range(const K& k) const {return t.equal_range(k);}
+
+
+    //order statistics(NodeUpdate must be rb_tree_order_statistics_update)
+    iterator nth(size_type k) const {return t.nth(k);}
+
+    size_type rank(const key_type& k) const {return t.rank(k);}
+
+    difference_type distance(iterator begin,iterator end) const {return t.distance(begin,end);}
+
+
+    //parallel traversal(needs parallel_tree.h),f is called concurrently
+    template <class Function>
+    void parallel_for_each(Function f,size_type threads=0) {rb_tree_parallel<rep_type>::for_each(t,f,threads);}
+
+    template <class Function>
+    void parallel_for_each(Function f,size_type threads=0) const {rb_tree_parallel<rep_type>::for_each(t,f,threads);}
+
+    template <class T,class BinaryOp,class Transform>
+    T parallel_reduce(T init,BinaryOp op,Transform tr,size_type threads=0) const
+    {
+        return rb_tree_parallel<rep_type>::reduce(t,init,op,tr,threads);
+    }
+
+
     //destructor
     ~multimap(){}
 
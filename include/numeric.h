@@ -2,6 +2,7 @@
 #define NUMERIC_H_INCLUDED
 
 #include "sstl.h"
+#include "iterator_traits.h"
 
 SSTL_NAMESPACE_BEGIN
 
@@ -14,6 +15,14 @@ T accumulate(Iterator begin,Iterator end,T sum)
     return sum;
 }
 
+template <class Iterator,class T,class BinaryOperation>
+T accumulate(Iterator begin,Iterator end,T sum,BinaryOperation op)
+{
+    while(begin!=end)
+        sum=op(sum,*begin++);
+    return sum;
+}
+
 
 //adjacent_difference
 template <class InputIterator,class OutputIterator>
@@ -40,11 +49,17 @@ T inner_product(InputIterator1 begin1,InputIterator1 end1,
                 InputIterator2 begin2,T sum)
 {
     for(;begin1!=end1;++begin1,++begin2)
-    {
         sum=sum+(*begin1)*(*begin2);
-        std::cout << sum << " ";
-    }
+    return sum;
+}
 
+//sum=op1(sum,op2(*begin1,*begin2))
+template <class InputIterator1,class InputIterator2,class T,class BinaryOperation1,class BinaryOperation2>
+T inner_product(InputIterator1 begin1,InputIterator1 end1,
+                InputIterator2 begin2,T sum,BinaryOperation1 op1,BinaryOperation2 op2)
+{
+    for(;begin1!=end1;++begin1,++begin2)
+        sum=op1(sum,op2(*begin1,*begin2));
     return sum;
 }
 
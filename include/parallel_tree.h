@@ -0,0 +1,184 @@
+#ifndef PARALLEL_TREE_H_INCLUDED
+#define PARALLEL_TREE_H_INCLUDED
+
+#include "sstl.h"
+#include "tree.h"
+#include "vector.h"
+#include "thread_pool.h"
+
+#include <atomic>
+#include <thread>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//parallel traversal of an rb_tree,behind parallel_for_each/parallel_reduce of
+//set,multiset,map and multimap.include this header to use them.
+//the tree is cut into in-order pieces:whole subtrees at a fixed depth and the
+//single nodes above them.threads(0:one per hardware thread) take pieces in turn
+//on the shared thread pool.the tree must not be modified meanwhile.
+template <class Tree>
+struct rb_tree_parallel
+{
+    typedef typename Tree::value_type   value_type;
+    typedef typename Tree::size_type    size_type;
+    typedef typename Tree::link_type    link_type;
+
+    //f(value_type&) on every element,in no particular order
+    template <class Function>
+    static void for_each(Tree& t,Function f,size_type threads=0)
+    {
+        for_each_aux<value_type&>(t,f,threads);
+    }
+
+    //f(const value_type&) on every element,in no particular order
+    template <class Function>
+    static void for_each(const Tree& t,Function f,size_type threads=0)
+    {
+        for_each_aux<const value_type&>(t,f,threads);
+    }
+
+    //init op tr(e1) op tr(e2) ...,in element order.op must be associative.
+    template <class T,class BinaryOp,class Transform>
+    static T reduce(const Tree& t,T init,BinaryOp op,Transform tr,size_type threads=0)
+    {
+        vector<tree_piece> pieces;
+        threads=split_for_threads(t,pieces,threads);
+        if(threads<=1){
+            for(typename Tree::iterator iter=t.begin();iter!=t.end();++iter)
+                init=op(init,tr(*iter));
+            return init;
+        }
+
+        vector<T> partial(pieces.size(),init);
+        std::atomic<size_type> next(0);
+        run_workers(threads,[&](){
+            for(size_type i;(i=next++)<pieces.size();)
+                partial.begin()[i]=reduce_piece<T>(pieces.begin()[i],op,tr);
+        });
+        for(size_type i=0;i<partial.size();++i)
+            init=op(init,partial.begin()[i]);
+        return init;
+    }
+
+private:
+
+    //trees below this size are walked by one thread
+    static constexpr size_type parallel_min_size=1 << 14;
+
+    struct tree_piece
+    {
+        link_type node;
+        bool whole;     //the subtree at node,or node alone
+    };
+
+    template <class Reference,class Function>
+    struct visit_node
+    {
+        Function* f;
+
+        void operator()(link_type p) const {(*f)(static_cast<Reference>(p->value));}
+    };
+
+    template <class T,class BinaryOp,class Transform>
+    struct reduce_node
+    {
+        T* acc;
+        BinaryOp* op;
+        Transform* tr;
+
+        void operator()(link_type p) const {*acc=(*op)(*acc,(*tr)(static_cast<const value_type&>(p->value)));}
+    };
+
+    template <class Reference,class Function>
+    static void for_each_aux(const Tree& t,Function& f,size_type threads)
+    {
+        vector<tree_piece> pieces;
+        threads=split_for_threads(t,pieces,threads);
+        if(threads<=1){
+            dfs_search_preorder(t.root(),visit_node<Reference,Function>{&f});
+            return;
+        }
+
+        std::atomic<size_type> next(0);
+        run_workers(threads,[&](){
+            Function local(f);
+            for(size_type i;(i=next++)<pieces.size();)
+                visit_piece<Reference>(pieces.begin()[i],local);
+        });
+    }
+
+    //pieces for about 8 per thread,returns the number of threads to use
+    static size_type split_for_threads(const Tree& t,vector<tree_piece>& pieces,size_type threads)
+    {
+        if(threads==0)
+            threads=std::thread::hardware_concurrency();
+        if(threads<=1 || t.size()<parallel_min_size)
+            return 1;
+
+        int depth=0;
+        while((size_type(1) << depth)<threads*8)
+            ++depth;
+        split_pieces(t.root(),depth,pieces);
+        return threads;
+    }
+
+    static void split_pieces(link_type p,int depth,vector<tree_piece>& pieces)
+    {
+        if(!p) return;
+        if(depth==0){
+            pieces.push_back(tree_piece{p,true});
+            return;
+        }
+        split_pieces(p->left,depth-1,pieces);
+        pieces.push_back(tree_piece{p,false});
+        split_pieces(p->right,depth-1,pieces);
+    }
+
+    template <class Reference,class Function>
+    static void visit_piece(const tree_piece& piece,Function& f)
+    {
+        if(piece.whole)
+            dfs_search_preorder(piece.node,visit_node<Reference,Function>{&f});
+        else
+            f(static_cast<Reference>(piece.node->value));
+    }
+
+    template <class T,class BinaryOp,class Transform>
+    static T reduce_piece(const tree_piece& piece,BinaryOp& op,Transform& tr)
+    {
+        link_type first=piece.node;
+        if(piece.whole)
+            while(first->left)
+                first=first->left;
+        T acc=tr(static_cast<const value_type&>(first->value));
+        if(piece.whole){
+            //the rest of the subtree in order:first's right subtree,then up.
+            reduce_node<T,BinaryOp,Transform> visit{&acc,&op,&tr};
+            dfs_search_preorder(first->right,visit);
+            for(link_type p=first;p!=piece.node;){
+                p=p->parent;
+                visit(p);
+                dfs_search_preorder(p->right,visit);
+            }
+        }
+        return acc;
+    }
+
+    //work() as threads tasks on the shared thread pool
+    template <class Work>
+    static void run_workers(size_type threads,Work work)
+    {
+        thread_pool::instance().run(threads,[&](size_t){work();});
+    }
+
+};
+
+template <class Tree>
+constexpr typename rb_tree_parallel<Tree>::size_type rb_tree_parallel<Tree>::parallel_min_size;
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // PARALLEL_TREE_H_INCLUDED
@@ -0,0 +1,500 @@
+#ifndef PERSISTENT_MAP_H_INCLUDED
+#define PERSISTENT_MAP_H_INCLUDED
+
+#include "sstl.h"
+#include "allocator.h"
+#include "iterator_traits.h"
+#include "function.h"
+#include "utilities.h"
+#include "tree.h"
+
+#include <atomic>
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//node of a persistent tree:no parent link,so one node can sit in many versions.
+//refs counts the links(parents and roots) to it.
+template <class T>
+struct persistent_tree_node
+{
+    typedef rb_tree_color_type color_type;
+
+    persistent_tree_node* left;
+    persistent_tree_node* right;
+    color_type color;
+    std::atomic<size_t> refs;
+    T value;
+};
+
+
+//the iterator keeps the path it came down,the current node on top.
+template <class T>
+struct persistent_tree_iterator
+{
+    //typedefs
+    typedef forward_iterator_tag    iterator_category;
+    typedef T                       value_type;
+    typedef const T&                reference;
+    typedef const T*                pointer;
+    typedef ptrdiff_t               difference_type;
+
+    typedef persistent_tree_iterator        iterator;
+    typedef persistent_tree_node<T>*        link_type;
+
+    //a left-leaning red-black tree of n nodes is at most 2log(n+1) high
+    static constexpr int max_height=96;
+
+
+    //current node and the ancestors whose left subtree we are in
+    link_type _stack[max_height];
+    int _depth;
+
+
+    //constructors
+    persistent_tree_iterator():_depth(0){}
+
+    persistent_tree_iterator(const iterator& iter):_depth(iter._depth)
+    {
+        for(int i=0;i<_depth;++i)
+            _stack[i]=iter._stack[i];
+    }
+
+    iterator& operator=(const iterator& iter)
+    {
+        _depth=iter._depth;
+        for(int i=0;i<_depth;++i)
+            _stack[i]=iter._stack[i];
+        return *this;
+    }
+
+
+    //data access
+    reference operator*() const {return _stack[_depth-1]->value;}
+
+    pointer operator->() const {return &(operator*());}
+
+
+    //arithmetic operations
+    iterator& operator++()
+    {
+        link_type p=_stack[--_depth]->right;
+        push_leftmost(p);
+        return *this;
+    }
+
+    iterator operator++(int)
+    {
+        iterator tmp=*this;
+        ++*this;
+        return tmp;
+    }
+
+    void push_leftmost(link_type p)
+    {
+        for(;p;p=p->left)
+            _stack[_depth++]=p;
+    }
+
+
+    //relational operations
+    link_type node() const {return _depth ? _stack[_depth-1] : nullptr;}
+
+    bool operator==(const iterator& iter) const {return node()==iter.node();}
+
+    bool operator!=(const iterator& iter) const {return node()!=iter.node();}
+
+};
+
+
+//persistent(copy-on-write) ordered map on a left-leaning red-black tree.
+//copying a map is O(1):both copies share every node.an update copies only the
+//nodes on its path that are still shared(path copying),so it is O(log n) and
+//never visible through other copies.nodes a map owns alone are updated in place.
+//
+//different copies may be read and updated from different threads at the same time;
+//a single copy follows the usual rules(no reads while it is written).
+//elements are const:use insert_or_assign to change a value.
+template <class Key,class Value,class Compare=less<Key>,class Alloc=malloc_alloc>
+class persistent_map
+{
+public:
+
+    //typedefs
+    typedef Key                         key_type;
+    typedef Value                       data_type;
+    typedef Value                       mapped_type;
+    typedef pair<key_type,data_type>    value_type;
+    typedef Compare                     key_compare;
+
+    typedef persistent_tree_iterator<value_type>    iterator;
+    typedef iterator                                const_iterator;
+    typedef const value_type*                       pointer;
+    typedef const value_type*                       const_pointer;
+    typedef const value_type&                       reference;
+    typedef const value_type&                       const_reference;
+    typedef size_t                                  size_type;
+    typedef ptrdiff_t                               difference_type;
+
+
+    //constructors
+    persistent_map():_root(nullptr),_size(0),_comp(key_compare()){}
+
+    explicit persistent_map(const key_compare& comp):_root(nullptr),_size(0),_comp(comp){}
+
+    template <class InputIterator>
+    persistent_map(InputIterator begin,InputIterator end,const key_compare& comp=key_compare())
+        :_root(nullptr),_size(0),_comp(comp)
+    {
+        insert(begin,end);
+    }
+
+    persistent_map(std::initializer_list<value_type> il):_root(nullptr),_size(0),_comp(key_compare())
+    {
+        insert(il.begin(),il.end());
+    }
+
+    //O(1),the new map shares all nodes
+    persistent_map(const persistent_map& m):_root(acquire(m._root)),_size(m._size),_comp(m._comp){}
+
+
+    //assignment
+    persistent_map& operator=(const persistent_map& m)
+    {
+        link_type old=_root;
+        _root=acquire(m._root);
+        release(old);
+        _size=m._size;
+        _comp=m._comp;
+        return *this;
+    }
+
+
+    //O(1) copy of the current version
+    persistent_map snapshot() const {return *this;}
+
+
+    //iterators
+    iterator begin() const
+    {
+        iterator iter;
+        iter.push_leftmost(_root);
+        return iter;
+    }
+
+    iterator end() const {return iterator();}
+
+    const_iterator cbegin() const {return begin();}
+
+    const_iterator cend() const {return end();}
+
+
+    //swap
+    void swap(persistent_map& m)
+    {
+        link_type tmp_root=_root;_root=m._root;m._root=tmp_root;
+        size_type tmp_size=_size;_size=m._size;m._size=tmp_size;
+        key_compare tmp_comp=_comp;_comp=m._comp;m._comp=tmp_comp;
+    }
+
+
+    //size
+    bool empty() const {return _size==0;}
+
+    size_type size() const {return _size;}
+
+
+    //insert
+    pair<iterator,bool> insert(const_reference value)
+    {
+        iterator iter=find(value.first);
+        if(iter!=end()) return {iter,false};
+        _root=insert_node(_root,value,false);
+        _root->color=rb_tree_black;
+        ++_size;
+        return {find(value.first),true};
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        for(;begin!=end;++begin)
+            insert(*begin);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        insert(il.begin(),il.end());
+    }
+
+    //returns true if k was inserted,false if its value was replaced
+    bool insert_or_assign(const key_type& k,const data_type& v)
+    {
+        bool inserted=find(k)==end();
+        _root=insert_node(_root,value_type(k,v),true);
+        _root->color=rb_tree_black;
+        if(inserted)
+            ++_size;
+        return inserted;
+    }
+
+
+    //erase
+    size_type erase(const key_type& k)
+    {
+        if(find(k)==end()) return 0;
+        _root=unique(_root);
+        if(!is_red(_root->left) && !is_red(_root->right))
+            _root->color=rb_tree_red;
+        _root=erase_node(_root,k);
+        if(_root)
+            _root->color=rb_tree_black;
+        --_size;
+        return 1;
+    }
+
+    void clear()
+    {
+        release(_root);
+        _root=nullptr;
+        _size=0;
+    }
+
+
+    //find
+    iterator find(const key_type& k) const
+    {
+        iterator iter=lower_bound(k);
+        return (iter!=end() && !_comp(k,iter->first)) ? iter : end();
+    }
+
+    size_type count(const key_type& k) const {return find(k)==end() ? 0 : 1;}
+
+    iterator lower_bound(const key_type& k) const
+    {
+        iterator iter;
+        for(link_type p=_root;p;){
+            if(_comp(get_key(p),k)){
+                p=p->right;
+            }else{
+                iter._stack[iter._depth++]=p;
+                p=p->left;
+            }
+        }
+        return iter;
+    }
+
+    iterator upper_bound(const key_type& k) const
+    {
+        iterator iter;
+        for(link_type p=_root;p;){
+            if(_comp(k,get_key(p))){
+                iter._stack[iter._depth++]=p;
+                p=p->left;
+            }else{
+                p=p->right;
+            }
+        }
+        return iter;
+    }
+
+    pair<iterator,iterator> equal_range(const key_type& k) const
+    {
+        return {lower_bound(k),upper_bound(k)};
+    }
+
+
+    //extra
+    key_compare key_comp() const {return _comp;}
+
+    //true if both maps are the same version(share the root)
+    bool same_version(const persistent_map& m) const {return _root==m._root;}
+
+
+    //destructor
+    ~persistent_map() {release(_root);}
+
+private:
+    typedef persistent_tree_node<value_type>*               link_type;
+    typedef simple_alloc<persistent_tree_node<value_type>,Alloc>  node_allocator;
+
+    link_type _root;
+    size_type _size;
+    key_compare _comp;
+
+
+    const key_type& get_key(link_type p) const {return p->value.first;}
+
+    static bool is_red(link_type p) {return p && p->color==rb_tree_red;}
+
+
+    //create and destroy
+    static link_type create_node(const_reference value)
+    {
+        link_type p=node_allocator::allocate();
+        construct(&p->value,value);
+        new(&p->refs) std::atomic<size_t>(1);
+        p->left=nullptr;
+        p->right=nullptr;
+        p->color=rb_tree_red;
+        return p;
+    }
+
+    static link_type acquire(link_type p)
+    {
+        if(p)
+            p->refs.fetch_add(1,std::memory_order_relaxed);
+        return p;
+    }
+
+    //drop one link to p,free what nobody links to anymore
+    static void release(link_type p)
+    {
+        while(p && p->refs.fetch_sub(1,std::memory_order_acq_rel)==1){
+            link_type right=p->right;
+            release(p->left);
+            destroy(&p->value);
+            node_allocator::deallocate(p);
+            p=right;
+        }
+    }
+
+    //the link holding p is about to change p:copy p if another version shares it.
+    //the caller's link moves to the copy.
+    static link_type unique(link_type p)
+    {
+        if(p->refs.load(std::memory_order_acquire)==1) return p;
+        link_type q=create_node(p->value);
+        q->left=acquire(p->left);
+        q->right=acquire(p->right);
+        q->color=p->color;
+        release(p);
+        return q;
+    }
+
+
+    //left-leaning red-black tree(Sedgewick),every node changed is made unique first
+    static link_type rotate_left(link_type h)
+    {
+        link_type x=unique(h->right);
+        h->right=x->left;
+        x->left=h;
+        x->color=h->color;
+        h->color=rb_tree_red;
+        return x;
+    }
+
+    static link_type rotate_right(link_type h)
+    {
+        link_type x=unique(h->left);
+        h->left=x->right;
+        x->right=h;
+        x->color=h->color;
+        h->color=rb_tree_red;
+        return x;
+    }
+
+    static void flip_colors(link_type h)
+    {
+        h->left=unique(h->left);
+        h->right=unique(h->right);
+        h->color=!h->color;
+        h->left->color=!h->left->color;
+        h->right->color=!h->right->color;
+    }
+
+    static link_type fixup(link_type h)
+    {
+        if(is_red(h->right) && !is_red(h->left))
+            h=rotate_left(h);
+        if(is_red(h->left) && is_red(h->left->left))
+            h=rotate_right(h);
+        if(is_red(h->left) && is_red(h->right))
+            flip_colors(h);
+        return h;
+    }
+
+    static link_type move_red_left(link_type h)
+    {
+        flip_colors(h);
+        if(is_red(h->right->left)){
+            h->right=rotate_right(unique(h->right));
+            h=rotate_left(h);
+            flip_colors(h);
+        }
+        return h;
+    }
+
+    static link_type move_red_right(link_type h)
+    {
+        flip_colors(h);
+        if(is_red(h->left->left)){
+            h=rotate_right(h);
+            flip_colors(h);
+        }
+        return h;
+    }
+
+
+    link_type insert_node(link_type h,const_reference value,bool assign)
+    {
+        if(!h) return create_node(value);
+        h=unique(h);
+        if(_comp(value.first,get_key(h)))
+            h->left=insert_node(h->left,value,assign);
+        else if(_comp(get_key(h),value.first))
+            h->right=insert_node(h->right,value,assign);
+        else if(assign)
+            h->value.second=value.second;
+        return fixup(h);
+    }
+
+    static link_type erase_min(link_type h)
+    {
+        if(!h->left){
+            release(h);
+            return nullptr;
+        }
+        if(!is_red(h->left) && !is_red(h->left->left))
+            h=move_red_left(h);
+        h->left=erase_min(unique(h->left));
+        return fixup(h);
+    }
+
+    //k is in the subtree at h,h is unique
+    link_type erase_node(link_type h,const key_type& k)
+    {
+        if(_comp(k,get_key(h))){
+            if(!is_red(h->left) && !is_red(h->left->left))
+                h=move_red_left(h);
+            h->left=erase_node(unique(h->left),k);
+        }else{
+            if(is_red(h->left))
+                h=rotate_right(h);
+            if(!_comp(get_key(h),k) && !h->right){
+                release(h);
+                return nullptr;
+            }
+            if(!is_red(h->right) && !is_red(h->right->left))
+                h=move_red_right(h);
+            if(!_comp(get_key(h),k)){
+                link_type min=h->right;
+                while(min->left)
+                    min=min->left;
+                h->value=min->value;
+                h->right=erase_min(unique(h->right));
+            }else{
+                h->right=erase_node(unique(h->right),k);
+            }
+        }
+        return fixup(h);
+    }
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // PERSISTENT_MAP_H_INCLUDED
@@ -49,7 +49,8 @@ private:
 };
 
 
-template <class T,class Sequence=vector<T>>
+//Compare orders the elements,top() is the greatest
+template <class T,class Sequence=vector<T>,class Compare=less<typename Sequence::value_type>>
 class priority_queue
 {
 public:
@@ -59,20 +60,23 @@ public:
     typedef typename Sequence::size_type        size_type;
     typedef typename Sequence::reference        reference;
     typedef typename Sequence::const_reference  const_reference;
+    typedef Compare                             value_compare;
 
 
     //_constructors
-    priority_queue():_con(){}
+    priority_queue():_con(),_comp(){}
+
+    explicit priority_queue(const Compare& comp):_con(),_comp(comp){}
 
     template <class InputIterator>
-    priority_queue(InputIterator begin,InputIterator end):_con(begin,end)
+    priority_queue(InputIterator begin,InputIterator end,const Compare& comp=Compare()):_con(begin,end),_comp(comp)
     {
-        make_heap(_con.begin(),_con.end());
+        make_heap(_con.begin(),_con.end(),_comp);
     }
 
-    priority_queue(std::initializer_list<value_type> il):_con(il)
+    priority_queue(std::initializer_list<value_type> il,const Compare& comp=Compare()):_con(il),_comp(comp)
     {
-        make_heap(_con.begin(),_con.end());
+        make_heap(_con.begin(),_con.end(),_comp);
     }
 
 
@@ -90,18 +94,19 @@ public:
     void push(const_reference value)
     {
         _con.push_back(value);
-        push_heap(_con.begin(),_con.end());
+        push_heap(_con.begin(),_con.end(),_comp);
     }
 
     void pop()
     {
-        pop_heap(_con.begin(),_con.end());
+        pop_heap(_con.begin(),_con.end(),_comp);
         _con.pop_back();
     }
 
 private:
 
     Sequence _con;
+    Compare _comp;
 
 };
 
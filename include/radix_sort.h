@@ -0,0 +1,275 @@
+#ifndef RADIX_SORT_H_INCLUDED
+#define RADIX_SORT_H_INCLUDED
+
+#include "sstl.h"
+#include "allocator.h"
+#include "iterator_traits.h"
+#include "type_traits.h"
+#include "function.h"
+#include "vector.h"
+#include "algorithm.h"
+
+#include <cstdint>
+#include <cstring>  //memcpy
+#include <type_traits>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//radix_sort:stable sorts on the digits of a key,linear in the number of elements,
+//no comparisons.
+//
+//arithmetic keys(integers,float,double) are sorted LSD:the key is mapped to an
+//unsigned integer of the same order,one histogram pass counts every digit at once,
+//then each digit moves the elements between the range and a buffer once,least
+//significant first.a digit all elements share is skipped.digits are 8 bits for keys
+//up to 16 bits,11 bits otherwise,or digit_bits(at most 16) if given:wider digits
+//mean fewer passes,but scatter to more places at once.NaNs go to the ends:negative
+//ones first,positive ones last.
+//
+//string keys(anything with size() and operator[] giving chars,like std::string) are
+//sorted MSD:elements are distributed on their byte at the current depth,strings that
+//end there first,and each bucket is sorted on the next depth.small buckets are left
+//to insertion sort.bytes compare as unsigned char.
+//
+//both need a buffer of n elements and fall back to stable_sort if it cannot be had.
+//key(value) extracts the key,for string keys it should return a reference.
+//
+//usage:
+//  sstl::radix_sort(ids.begin(),ids.end());
+//  sstl::radix_sort(recs.begin(),recs.end(),[](const rec& r){return r.timestamp;});
+//  sstl::radix_sort(ids.begin(),ids.end(),sstl::identity<uint64_t>(),16);
+//  sstl::radix_sort(names.begin(),names.end());
+
+//smaller ranges go to stable_sort
+const size_t radix_sort_min_size=256;
+
+//MSD buckets below this size are insertion sorted
+const size_t radix_sort_string_threshold=32;
+
+
+//keys as unsigned integers of the same order
+template <size_t Bytes> struct radix_unsigned;
+template <> struct radix_unsigned<1>{typedef std::uint8_t type;};
+template <> struct radix_unsigned<2>{typedef std::uint16_t type;};
+template <> struct radix_unsigned<4>{typedef std::uint32_t type;};
+template <> struct radix_unsigned<8>{typedef std::uint64_t type;};
+
+//integers:signed ones get the sign bit flipped
+template <class Key>
+typename radix_unsigned<sizeof(Key)>::type radix_encode(Key k,false_type)
+{
+    typedef typename radix_unsigned<sizeof(Key)>::type U;
+    U u=static_cast<U>(k);
+    return std::is_signed<Key>::value ? U(u^(U(1) << (8*sizeof(Key)-1))) : u;
+}
+
+//floating point:negative numbers get all bits flipped,others the sign bit
+template <class Key>
+typename radix_unsigned<sizeof(Key)>::type radix_encode(Key k,true_type)
+{
+    typedef typename radix_unsigned<sizeof(Key)>::type U;
+    U u;
+    std::memcpy(&u,&k,sizeof(k));
+    U sign=U(1) << (8*sizeof(Key)-1);
+    return (u & sign) ? U(~u) : U(u | sign);
+}
+
+
+//LSD
+//move every element to its slot in result,next[d] is where digit d goes next
+template <class InputIterator,class OutputIterator,class KeyOfValue,class IsFloat>
+void radix_scatter(InputIterator begin,InputIterator end,OutputIterator result,size_t* next,
+                   int shift,size_t mask,KeyOfValue& key,IsFloat)
+{
+    for(;begin!=end;++begin)
+        result[next[(radix_encode(key(*begin),IsFloat()) >> shift) & mask]++]=std::move(*begin);
+}
+
+template <class RandomAccessIterator,class KeyOfValue>
+void radix_sort_dispatch(RandomAccessIterator begin,RandomAccessIterator end,KeyOfValue key,
+                         int digit_bits,true_type)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+    typedef typename std::decay<decltype(key(*begin))>::type key_type;
+    typedef typename bool_tag<std::is_floating_point<key_type>::value>::type is_float;
+
+    static_assert(sizeof(key_type)<=8,"radix_sort keys are at most 64 bits");
+
+    size_t n=end-begin;
+    auto less_key=[&](const value_type& a,const value_type& b){
+        return radix_encode(key(a),is_float())<radix_encode(key(b),is_float());
+    };
+    if(n<radix_sort_min_size){
+        sstl::stable_sort(begin,end,less_key);
+        return;
+    }
+    temporary_buffer<value_type> buffer(begin,n);
+    if(buffer.size()<n){
+        sstl::stable_sort(begin,end,less_key);
+        return;
+    }
+
+    const int key_bits=8*sizeof(key_type);
+    if(digit_bits<=0 || digit_bits>16)
+        digit_bits=key_bits<=16 ? 8 : 11;
+    const int passes=(key_bits+digit_bits-1)/digit_bits;
+    const size_t radix=size_t(1) << digit_bits;
+    const size_t mask=radix-1;
+
+    //histogram of every digit in one pass
+    vector<size_t> count(passes*radix,0);
+    for(RandomAccessIterator iter=begin;iter!=end;++iter){
+        auto u=radix_encode(key(*iter),is_float());
+        for(int p=0;p<passes;++p)
+            ++count.begin()[p*radix+((u >> (p*digit_bits)) & mask)];
+    }
+
+    bool in_buffer=false;
+    for(int p=0;p<passes;++p){
+        size_t* next=count.begin()+p*radix;
+        int shift=p*digit_bits;
+        auto first=radix_encode(key(in_buffer ? *buffer.begin() : *begin),is_float());
+        if(next[(first >> shift) & mask]==n)   //one digit for all:the order stays
+            continue;
+
+        size_t position=0;
+        for(size_t d=0;d<radix;++d){
+            size_t k=next[d];
+            next[d]=position;
+            position+=k;
+        }
+        if(in_buffer)
+            radix_scatter(buffer.begin(),buffer.end(),begin,next,shift,mask,key,is_float());
+        else
+            radix_scatter(begin,end,buffer.begin(),next,shift,mask,key,is_float());
+        in_buffer=!in_buffer;
+    }
+    if(in_buffer)
+        sstl::merge_move(buffer.begin(),buffer.end(),begin);
+}
+
+
+//MSD
+//byte of s at depth,shifted up by one:0 means s ends before depth
+template <class String>
+size_t radix_byte(const String& s,size_t depth)
+{
+    return depth<s.size() ? size_t(static_cast<unsigned char>(s[depth]))+1 : 0;
+}
+
+//a<b for keys that share their first depth bytes
+template <class String>
+bool radix_string_less(const String& a,const String& b,size_t depth)
+{
+    size_t n=a.size()<b.size() ? a.size() : b.size();
+    for(;depth<n;++depth){
+        unsigned char x=static_cast<unsigned char>(a[depth]);
+        unsigned char y=static_cast<unsigned char>(b[depth]);
+        if(x!=y) return x<y;
+    }
+    return a.size()<b.size();
+}
+
+template <class KeyOfValue>
+struct radix_string_compare
+{
+    KeyOfValue* key;
+    size_t depth;
+
+    template <class T>
+    bool operator()(const T& a,const T& b) const {return radix_string_less((*key)(a),(*key)(b),depth);}
+};
+
+//elements [first,last) share the first depth bytes of their keys
+struct radix_string_bucket
+{
+    size_t first;
+    size_t last;
+    size_t depth;
+};
+
+template <class RandomAccessIterator,class KeyOfValue>
+void radix_sort_dispatch(RandomAccessIterator begin,RandomAccessIterator end,KeyOfValue key,
+                         int,false_type)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+
+    size_t n=end-begin;
+    if(n<radix_sort_min_size){
+        sstl::stable_sort(begin,end,radix_string_compare<KeyOfValue>{&key,0});
+        return;
+    }
+    temporary_buffer<value_type> buffer(begin,n);
+    if(buffer.size()<n){
+        sstl::stable_sort(begin,end,radix_string_compare<KeyOfValue>{&key,0});
+        return;
+    }
+
+    const size_t radix=257;
+    vector<unsigned short> byte(n);
+    vector<radix_string_bucket> todo;
+    todo.push_back(radix_string_bucket{0,n,0});
+    while(!todo.empty()){
+        radix_string_bucket bucket=todo.back();
+        todo.pop_back();
+        size_t first=bucket.first;
+        size_t last=bucket.last;
+        size_t depth=bucket.depth;
+        if(last-first<radix_sort_string_threshold){
+            sstl::insertion_sort(begin+first,begin+last,radix_string_compare<KeyOfValue>{&key,depth});
+            continue;
+        }
+
+        size_t count[radix]={0};
+        for(size_t i=first;i<last;++i){
+            size_t b=radix_byte(key(begin[i]),depth);
+            byte.begin()[i]=static_cast<unsigned short>(b);
+            ++count[b];
+        }
+        size_t b=byte.begin()[first];
+        if(count[b]==last-first){   //one byte for all:nothing moves
+            if(b!=0)
+                todo.push_back(radix_string_bucket{first,last,depth+1});
+            continue;
+        }
+
+        size_t next[radix];
+        size_t position=first;
+        for(size_t d=0;d<radix;++d){
+            next[d]=position;
+            position+=count[d];
+        }
+        for(size_t i=first;i<last;++i)
+            buffer.begin()[next[byte.begin()[i]]++]=std::move(begin[i]);
+        sstl::merge_move(buffer.begin()+first,buffer.begin()+last,begin+first);
+
+        //bucket d now ends at next[d];the keys that ended(bucket 0) are done
+        for(size_t d=radix-1;d>0;--d)
+            if(count[d]>1)
+                todo.push_back(radix_string_bucket{next[d]-count[d],next[d],depth+1});
+    }
+}
+
+
+//digit_bits:LSD digit width,0 to choose(ignored for string keys)
+template <class RandomAccessIterator,class KeyOfValue>
+void radix_sort(RandomAccessIterator begin,RandomAccessIterator end,KeyOfValue key,int digit_bits=0)
+{
+    typedef typename std::decay<decltype(key(*begin))>::type key_type;
+    radix_sort_dispatch(begin,end,key,digit_bits,
+                        typename bool_tag<std::is_arithmetic<key_type>::value>::type());
+}
+
+template <class RandomAccessIterator>
+void radix_sort(RandomAccessIterator begin,RandomAccessIterator end)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+    sstl::radix_sort(begin,end,identity<value_type>());
+}
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // RADIX_SORT_H_INCLUDED
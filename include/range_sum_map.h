@@ -0,0 +1,208 @@
+#ifndef RANGE_SUM_MAP_H_INCLUDED
+#define RANGE_SUM_MAP_H_INCLUDED
+
+#include "tree.h"
+
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//sum augmentation:metadata is the sum of mapped values in the subtree.
+template <class Value>
+struct subtree_sum_update
+{
+    typedef Value metadata_type;
+
+    template <class PNode>
+    void operator()(PNode p) const
+    {
+        p->metadata=p->value.second;
+        if(p->left)
+            p->metadata=p->metadata+p->left->metadata;
+        if(p->right)
+            p->metadata=p->metadata+p->right->metadata;
+    }
+};
+
+
+//map with O(log n) prefix and range sums over the mapped values.
+//values are read-only through iterators,use assign/add to modify them.
+template <class Key,class Value,class Compare=less<Key>,class Alloc=malloc_alloc>
+class range_sum_map
+{
+public:
+
+    //typedefs
+    typedef Key                         key_type;
+    typedef Value                       data_type;
+    typedef Value                       mapped_type;
+    typedef pair<key_type,data_type>    value_type;
+    typedef Compare                     key_compare;
+
+    typedef rb_tree<key_type,value_type,select1st<value_type>,key_compare,Alloc,
+                    subtree_sum_update<data_type>> rep_type;
+
+    typedef typename rep_type::const_iterator           iterator;
+    typedef typename rep_type::const_iterator           const_iterator;
+    typedef typename rep_type::const_reverse_iterator   reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator   const_reverse_iterator;
+    typedef typename rep_type::const_pointer            pointer;
+    typedef typename rep_type::const_pointer            const_pointer;
+    typedef typename rep_type::const_reference          reference;
+    typedef typename rep_type::const_reference          const_reference;
+    typedef typename rep_type::size_type                size_type;
+    typedef typename rep_type::difference_type          difference_type;
+
+
+    //constructors
+    range_sum_map():t(key_compare()){}
+
+    explicit range_sum_map(const key_compare& comp):t(comp){}
+
+    template <class InputIterator>
+    range_sum_map(InputIterator begin,InputIterator end,const key_compare& comp=key_compare()):t(comp)
+    {
+        t.insert_unique(begin,end);
+    }
+
+    range_sum_map(std::initializer_list<value_type> il):t(key_compare())
+    {
+        t.insert_unique(il.begin(),il.end());
+    }
+
+    range_sum_map(const range_sum_map& m):t(m.t){}
+
+
+    //assignment
+    range_sum_map& operator=(const range_sum_map& m) {t=m.t;return *this;}
+
+
+    //iterators
+    iterator begin() const {return t.cbegin();}
+
+    iterator end() const {return t.cend();}
+
+    reverse_iterator rbegin() const {return t.crbegin();}
+
+    reverse_iterator rend() const {return t.crend();}
+
+
+    //swap
+    void swap(range_sum_map& m) {t.swap(m.t);}
+
+
+    //size
+    bool empty() const {return t.empty();}
+
+    size_type size() const {return t.size();}
+
+
+    //insert
+    pair<iterator,bool> insert(const_reference value)
+    {
+        pair<typename rep_type::iterator,bool> ret=t.insert_unique(value);
+        return {iterator(ret.first),ret.second};
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end) {t.insert_unique(begin,end);}
+
+    void insert(std::initializer_list<value_type> il) {t.insert_unique(il.begin(),il.end());}
+
+
+    //modify
+    //set the value of k(insert it if absent)
+    iterator assign(const key_type& k,const data_type& value)
+    {
+        pair<typename rep_type::iterator,bool> ret=t.insert_unique(value_type(k,value));
+        if(!ret.second){
+            ret.first->second=value;
+            t.update_metadata(ret.first);
+        }
+        return iterator(ret.first);
+    }
+
+    //add delta to the value of k(insert delta if absent)
+    iterator add(const key_type& k,const data_type& delta)
+    {
+        pair<typename rep_type::iterator,bool> ret=t.insert_unique(value_type(k,delta));
+        if(!ret.second){
+            ret.first->second=ret.first->second+delta;
+            t.update_metadata(ret.first);
+        }
+        return iterator(ret.first);
+    }
+
+
+    //erase
+    void erase(iterator tar) {t.erase(tar.base());}
+
+    void erase(const key_type& k) {t.erase(k);}
+
+    void erase(iterator begin,iterator end) {t.erase(begin.base(),end.base());}
+
+    void clear() {t.clear();}
+
+
+    //unique
+    iterator find(const key_type& k) const {return iterator(t.find(k));}
+
+    size_type count(const key_type& k) const {return t.count(k);}
+
+    iterator lower_bound(const key_type& k) const {return iterator(t.lower_bound(k));}
+
+    iterator upper_bound(const key_type& k) const {return iterator(t.upper_bound(k));}
+
+
+    //sums
+    //sum of all values
+    data_type sum() const
+    {
+        return t.root() ? t.root()->metadata : data_type();
+    }
+
+    //sum of values whose key is less than k
+    data_type prefix_sum(const key_type& k) const
+    {
+        key_compare comp=t.key_comp();
+        data_type result=data_type();
+        link_type cur=t.root();
+        while(cur){
+            if(comp(cur->value.first,k)){
+                if(cur->left)
+                    result=result+cur->left->metadata;
+                result=result+cur->value.second;
+                cur=cur->right;
+            }else{
+                cur=cur->left;
+            }
+        }
+        return result;
+    }
+
+    //sum of values whose key is in [low,high)
+    data_type range_sum(const key_type& low,const key_type& high) const
+    {
+        return prefix_sum(high)-prefix_sum(low);
+    }
+
+
+    //extra
+    key_compare key_comp() const {return t.key_comp();}
+
+    ~range_sum_map(){}
+
+private:
+
+    typedef typename rep_type::link_type link_type;
+
+    rep_type t;
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // RANGE_SUM_MAP_H_INCLUDED
@@ -0,0 +1,129 @@
+#ifndef RW_LOCK_H_INCLUDED
+#define RW_LOCK_H_INCLUDED
+
+#include "sstl.h"
+
+#include <atomic>
+#include <thread>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//reader-writer spin lock in one word,for short critical sections.
+//a waiting writer blocks new readers,so writers are not starved by a stream of lookups.
+class rw_spin_lock
+{
+public:
+
+    rw_spin_lock():_state(0){}
+
+    rw_spin_lock(const rw_spin_lock&)=delete;
+
+    rw_spin_lock& operator=(const rw_spin_lock&)=delete;
+
+
+    //shared(reader) side
+    //fails only on a writer,a cas lost to other readers is retried
+    bool try_lock_shared()
+    {
+        unsigned s=_state.load(std::memory_order_relaxed);
+        while(!(s&(writer|pending))){
+            if(_state.compare_exchange_weak(s,s+reader,std::memory_order_acquire,std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    void lock_shared()
+    {
+        for(unsigned spin=0;!try_lock_shared();++spin)
+            backoff(spin);
+    }
+
+    void unlock_shared() {_state.fetch_sub(reader,std::memory_order_release);}
+
+
+    //exclusive(writer) side
+    bool try_lock()
+    {
+        unsigned s=_state.load(std::memory_order_relaxed);
+        if(s&~pending) return false;
+        return _state.compare_exchange_strong(s,writer,std::memory_order_acquire,std::memory_order_relaxed);
+    }
+
+    void lock()
+    {
+        for(unsigned spin=0;;++spin){
+            unsigned s=_state.load(std::memory_order_relaxed);
+            if(!(s&~pending)){
+                if(_state.compare_exchange_weak(s,writer,std::memory_order_acquire,std::memory_order_relaxed))
+                    return;
+            }else if(!(s&pending)){
+                _state.fetch_or(pending,std::memory_order_relaxed);
+            }
+            backoff(spin);
+        }
+    }
+
+    void unlock() {_state.fetch_and(~writer,std::memory_order_release);}
+
+private:
+
+    static constexpr unsigned writer=1;
+    static constexpr unsigned pending=2;
+    static constexpr unsigned reader=4;
+
+    std::atomic<unsigned> _state;
+
+
+    static void backoff(unsigned spin)
+    {
+        if(spin>=64)
+            std::this_thread::yield();
+    }
+
+};
+
+
+//RAII guards
+template <class Lock>
+class shared_lock_guard
+{
+public:
+
+    explicit shared_lock_guard(Lock& lock):_lock(lock) {_lock.lock_shared();}
+
+    shared_lock_guard(const shared_lock_guard&)=delete;
+
+    shared_lock_guard& operator=(const shared_lock_guard&)=delete;
+
+    ~shared_lock_guard() {_lock.unlock_shared();}
+
+private:
+
+    Lock& _lock;
+};
+
+template <class Lock>
+class unique_lock_guard
+{
+public:
+
+    explicit unique_lock_guard(Lock& lock):_lock(lock) {_lock.lock();}
+
+    unique_lock_guard(const unique_lock_guard&)=delete;
+
+    unique_lock_guard& operator=(const unique_lock_guard&)=delete;
+
+    ~unique_lock_guard() {_lock.unlock();}
+
+private:
+
+    Lock& _lock;
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // RW_LOCK_H_INCLUDED
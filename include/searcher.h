@@ -0,0 +1,223 @@
+#ifndef SEARCHER_H_INCLUDED
+#define SEARCHER_H_INCLUDED
+
+#include "sstl.h"
+#include "iterator_traits.h"
+#include "utilities.h"
+#include "function.h"
+
+#include <climits>  //UCHAR_MAX
+#include <type_traits>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//searchers:preprocess a pattern once,then find it in any number of ranges.
+//a searcher keeps the pattern's iterators,the pattern must outlive it.
+//searcher(begin,end) returns the first match as [first,last),or {end,end}.
+//
+//usage:
+//  horspool_searcher<const char*> s(pattern,pattern+len);
+//  for(...) pos=search(buffer,buffer+size,s);
+
+
+//Boyer-Moore-Horspool for integral elements.
+//compares the pattern's last position first;on a mismatch it shifts by how far
+//the text element under that position is from the pattern's end(the whole
+//length if it is not in the pattern).sublinear on average,O(n*m) worst case.
+//the shift table is indexed by the element's low byte:elements sharing a byte
+//share the smallest shift,which is exact for byte ranges and still safe for wider ones.
+template <class RandomAccessIterator2>
+class horspool_searcher
+{
+public:
+
+    typedef typename iterator_traits<RandomAccessIterator2>::difference_type difference_type;
+
+    static_assert(std::is_integral<typename iterator_traits<RandomAccessIterator2>::value_type>::value,
+                  "horspool_searcher needs an integral pattern");
+
+
+    //constructor
+    horspool_searcher(RandomAccessIterator2 begin,RandomAccessIterator2 end)
+        :_begin(begin),_length(end-begin)
+    {
+        for(int i=0;i<=UCHAR_MAX;++i)
+            _skip[i]=_length;
+        for(difference_type i=0;i<_length-1;++i)
+            _skip[static_cast<unsigned char>(_begin[i])]=_length-1-i;
+    }
+
+
+    //search
+    template <class RandomAccessIterator1>
+    pair<RandomAccessIterator1,RandomAccessIterator1>
+    operator()(RandomAccessIterator1 begin,RandomAccessIterator1 end) const
+    {
+        if(_length==0) return {begin,begin};
+
+        difference_type last=_length-1;
+        for(difference_type left=end-begin;left>=_length;){
+            const auto& value=begin[last];
+            if(value==_begin[last]){
+                difference_type i=last-1;
+                while(i>=0 && begin[i]==_begin[i])
+                    --i;
+                if(i<0) return {begin,begin+_length};
+            }
+            difference_type shift=_skip[static_cast<unsigned char>(value)];
+            begin+=shift;
+            left-=shift;
+        }
+        return {end,end};
+    }
+
+private:
+
+    RandomAccessIterator2 _begin;
+    difference_type _length;
+    difference_type _skip[UCHAR_MAX+1];
+};
+
+
+//equivalence under comp,plain == for less<>(one comparison in the inner loops)
+template <class Compare,class T1,class T2>
+bool searcher_equivalent(const Compare& comp,const T1& a,const T2& b)
+{
+    return !comp(a,b) && !comp(b,a);
+}
+
+template <class T1,class T2>
+bool searcher_equivalent(const less<>&,const T1& a,const T2& b)
+{
+    return a==b;
+}
+
+
+//Two-Way(Crochemore-Perrin) for any ordered element type.
+//the pattern is cut at a critical factorization u|v:v is matched left to right,
+//then u right to left,and the shift after a mismatch never loses a match.
+//O(n+m) time,O(1) extra space,no alphabet table.
+//elements a and b are equal when neither comp(a,b) nor comp(b,a).
+template <class RandomAccessIterator2,class Compare=less<>>
+class two_way_searcher
+{
+public:
+
+    typedef typename iterator_traits<RandomAccessIterator2>::difference_type difference_type;
+
+
+    //constructor
+    two_way_searcher(RandomAccessIterator2 begin,RandomAccessIterator2 end,Compare comp=Compare())
+        :_begin(begin),_length(end-begin),_comp(comp)
+    {
+        if(_length==0){
+            _suffix=0;
+            _period=1;
+            _periodic=false;
+            return;
+        }
+
+        difference_type period,period_rev;
+        difference_type suffix=max_suffix(false,period);
+        difference_type suffix_rev=max_suffix(true,period_rev);
+        if(suffix>suffix_rev){
+            _suffix=suffix+1;
+            _period=period;
+        }else{
+            _suffix=suffix_rev+1;
+            _period=period_rev;
+        }
+
+        //periodic if u is a suffix of its period-shifted copy
+        _periodic=true;
+        for(difference_type i=0;i<_suffix;++i)
+            if(!equal(_begin[i],_begin[i+_period])){
+                _periodic=false;
+                break;
+            }
+        if(!_periodic)
+            _period=(_suffix>_length-_suffix ? _suffix : _length-_suffix)+1;
+    }
+
+
+    //search
+    template <class RandomAccessIterator1>
+    pair<RandomAccessIterator1,RandomAccessIterator1>
+    operator()(RandomAccessIterator1 begin,RandomAccessIterator1 end) const
+    {
+        if(_length==0) return {begin,begin};
+
+        difference_type n=end-begin;
+        difference_type memory=0;   //prefix already known to match(periodic case)
+        for(difference_type j=0;j<=n-_length;){
+            difference_type i=_periodic && memory>_suffix ? memory : _suffix;
+            while(i<_length && equal(_begin[i],begin[i+j]))
+                ++i;
+            if(i<_length){
+                j+=i-_suffix+1;
+                memory=0;
+                continue;
+            }
+
+            difference_type low=_periodic ? memory : 0;
+            i=_suffix-1;
+            while(i>=low && equal(_begin[i],begin[i+j]))
+                --i;
+            if(i<low) return {begin+j,begin+(j+_length)};
+
+            j+=_period;
+            if(_periodic)
+                memory=_length-_period;
+        }
+        return {end,end};
+    }
+
+private:
+
+    RandomAccessIterator2 _begin;
+    difference_type _length;
+    difference_type _suffix;    //the cut:u=[0,_suffix),v=[_suffix,_length)
+    difference_type _period;
+    bool _periodic;
+    Compare _comp;
+
+
+    template <class T1,class T2>
+    bool equal(const T1& a,const T2& b) const {return searcher_equivalent(_comp,a,b);}
+
+    //start-1 of the maximal suffix(reverse:for the reversed order),period its period
+    difference_type max_suffix(bool reverse,difference_type& period) const
+    {
+        difference_type start=-1;
+        difference_type j=0;
+        difference_type k=1;
+        period=1;
+        while(j+k<_length){
+            const auto& a=_begin[j+k];
+            const auto& b=_begin[start+k];
+            if(reverse ? _comp(b,a) : _comp(a,b)){
+                j+=k;
+                k=1;
+                period=j-start;
+            }else if(equal(a,b)){
+                if(k!=period)
+                    ++k;
+                else{
+                    j+=period;
+                    k=1;
+                }
+            }else{
+                start=j++;
+                k=period=1;
+            }
+        }
+        return start;
+    }
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // SEARCHER_H_INCLUDED
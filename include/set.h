@@ -8,7 +8,7 @@
 
 SSTL_NAMESPACE_BEGIN
 
-template <class Key,class Compare=less<Key>,class Alloc=malloc_alloc>
+template <class Key,class Compare=less<Key>,class Alloc=malloc_alloc,class NodeUpdate=rb_tree_null_update>
 class set
 {
 public:
@@ -19,7 +19,7 @@ public:
     typedef Compare key_compare;
     typedef Compare value_compare;
 
-    typedef rb_tree<key_type,value_type,identity<value_type>,key_compare,Alloc> rep_type;
+    typedef rb_tree<key_type,value_type,identity<value_type>,key_compare,Alloc,NodeUpdate> rep_type;
 
     //common
     typedef typename rep_type::const_iterator           iterator;
@@ -130,6 +130,46 @@ public:
     }
 
 
+    //heterogeneous lookup,only with a transparent comparator(less<>)
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator find(const K& k) const {return iterator(t.find(k));}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    size_type count(const K& k) const {return t.count(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator lower_bound(const K& k) const {return iterator(t.lower_bound(k));}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator upper_bound(const K& k) const {return iterator(t.upper_bound(k));}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    pair<iterator,iterator> equal_range(const K& k) const
+    {
+        pair<typename rep_type::iterator,typename rep_type::iterator> ret=t.equal_range(k);
+        return {iterator(ret.first),iterator(ret.second)};
+    }
+
+
+    //order statistics(NodeUpdate must be rb_tree_order_statistics_update)
+    iterator nth(size_type k) const {return iterator(t.nth(k));}
+
+    size_type rank(const key_type& k) const {return t.rank(k);}
+
+    difference_type distance(iterator begin,iterator end) const {return t.distance(begin.base(),end.base());}
+
+
+    //parallel traversal(needs parallel_tree.h),f is called concurrently on const elements
+    template <class Function>
+    void parallel_for_each(Function f,size_type threads=0) const {rb_tree_parallel<rep_type>::for_each(t,f,threads);}
+
+    template <class T,class BinaryOp,class Transform>
+    T parallel_reduce(T init,BinaryOp op,Transform tr,size_type threads=0) const
+    {
+        return rb_tree_parallel<rep_type>::reduce(t,init,op,tr,threads);
+    }
+
+
     //extra
     key_compare key_comp() const {return t.key_comp();}
 
@@ -146,7 +186,7 @@ private:
 
 
 
-template <class Key,class Compare=less<Key>,class Alloc=malloc_alloc>
+template <class Key,class Compare=less<Key>,class Alloc=malloc_alloc,class NodeUpdate=rb_tree_null_update>
 class multiset
 {
 public:
@@ -157,7 +197,7 @@ public:
     typedef Compare key_compare;
     typedef Compare value_compare;
 
-    typedef rb_tree<key_type,value_type,identity<value_type>,key_compare,Alloc> rep_type;
+    typedef rb_tree<key_type,value_type,identity<value_type>,key_compare,Alloc,NodeUpdate> rep_type;
 
     //common
     typedef typename rep_type::const_iterator           iterator;
@@ -266,6 +306,46 @@ public:
     }
 
 
+    //heterogeneous lookup,only with a transparent comparator(less<>)
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator find(const K& k) const {return iterator(t.find(k));}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    size_type count(const K& k) const {return t.count(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator lower_bound(const K& k) const {return iterator(t.lower_bound(k));}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator upper_bound(const K& k) const {return iterator(t.upper_bound(k));}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    pair<iterator,iterator> equal_range(const K& k) const
+    {
+        pair<typename rep_type::iterator,typename rep_type::iterator> ret=t.equal_range(k);
+        return {iterator(ret.first),iterator(ret.second)};
+    }
+
+
+    //order statistics(NodeUpdate must be rb_tree_order_statistics_update)
+    iterator nth(size_type k) const {return iterator(t.nth(k));}
+
+    size_type rank(const key_type& k) const {return t.rank(k);}
+
+    difference_type distance(iterator begin,iterator end) const {return t.distance(begin.base(),end.base());}
+
+
+    //parallel traversal(needs parallel_tree.h),f is called concurrently on const elements
+    template <class Function>
+    void parallel_for_each(Function f,size_type threads=0) const {rb_tree_parallel<rep_type>::for_each(t,f,threads);}
+
+    template <class T,class BinaryOp,class Transform>
+    T parallel_reduce(T init,BinaryOp op,Transform tr,size_type threads=0) const
+    {
+        return rb_tree_parallel<rep_type>::reduce(t,init,op,tr,threads);
+    }
+
+
     //extra
     key_compare key_comp() const {return t.key_comp();}
 
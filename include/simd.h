@@ -0,0 +1,695 @@
+#ifndef SIMD_H_INCLUDED
+#define SIMD_H_INCLUDED
+
+#include "sstl.h"
+#include "type_traits.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>  //memcmp
+#include <limits>
+#include <type_traits>
+
+//x86 builds get SSE2 kernels(always there on x86-64) and AVX2 ones picked at run
+//time through CPUID.the AVX2 code is compiled with a target attribute,so nothing
+//needs -mavx2.other targets and compilers use the scalar loops.
+#if (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))) && defined(__GNUC__)
+#define SSTL_SIMD 1
+#include <immintrin.h>
+#else
+#define SSTL_SIMD 0
+#endif
+
+
+SSTL_NAMESPACE_BEGIN
+
+//raw pointers to integral elements(bool aside) are scanned by the kernels below.
+//they work on the unsigned type of the same size:equal values are equal bits.
+template <class Iterator>
+struct is_scan_pointer
+{
+    static constexpr bool value=false;
+};
+
+template <class T>
+struct is_scan_pointer<T*>
+{
+    static constexpr bool value=std::is_integral<T>::value
+                                && !std::is_same<typename std::remove_cv<T>::type,bool>::value;
+};
+
+//find and count:an integral value
+template <class Iterator,class T>
+struct is_scan_value
+{
+    static constexpr bool value=is_scan_pointer<Iterator>::value && std::is_integral<T>::value;
+};
+
+//equal and mismatch:both elements of the same size.types narrower than int are
+//promoted before they compare,so their signedness must match too:(signed char)-1
+//and (unsigned char)255 share their bits but are -1 and 255.from int up mixed
+//signedness converts both sides to the unsigned type,so equal bits stay equal values.
+template <class Iterator1,class Iterator2>
+struct is_scan_pair
+{
+    static constexpr bool value=false;
+};
+
+template <class T1,class T2>
+struct is_scan_pair<T1*,T2*>
+{
+    static constexpr bool value=is_scan_pointer<T1*>::value && is_scan_pointer<T2*>::value
+                                && sizeof(T1)==sizeof(T2)
+                                && (sizeof(T1)>=sizeof(int) || std::is_signed<T1>::value==std::is_signed<T2>::value);
+};
+
+template <class T>
+struct scan_unsigned
+{
+    typedef typename std::make_unsigned<typename std::remove_cv<T>::type>::type type;
+};
+
+
+//scalar kernels,also the tails of the vector ones
+template <class U>
+size_t scalar_find(const U* p,size_t i,size_t n,U value)
+{
+    while(i<n && p[i]!=value)
+        ++i;
+    return i;
+}
+
+template <class U>
+size_t scalar_count(const U* p,size_t i,size_t n,U value)
+{
+    size_t c=0;
+    for(;i<n;++i)
+        c+=p[i]==value;
+    return c;
+}
+
+template <class U>
+size_t scalar_mismatch(const U* a,const U* b,size_t i,size_t n)
+{
+    while(i<n && a[i]==b[i])
+        ++i;
+    return i;
+}
+
+//first i with p[i]==p[i+1],n if none
+template <class U>
+size_t scalar_adjacent_find(const U* p,size_t i,size_t n)
+{
+    for(;i+1<n;++i)
+        if(p[i]==p[i+1])
+            return i;
+    return n;
+}
+
+
+#if SSTL_SIMD
+
+#define SSTL_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+
+//cpuid once,thread-safe through the static
+inline bool simd_has_avx2()
+{
+    static const bool avx2=(__builtin_cpu_init(),__builtin_cpu_supports("avx2")!=0);
+    return avx2;
+}
+
+
+//SSE2:16 bytes per step
+inline __m128i sse2_load(const void* p) {return _mm_loadu_si128(static_cast<const __m128i*>(p));}
+
+inline unsigned sse2_movemask(__m128i v) {return static_cast<unsigned>(_mm_movemask_epi8(v));}
+
+inline __m128i sse2_set1(unsigned char v) {return _mm_set1_epi8(static_cast<char>(v));}
+inline __m128i sse2_set1(unsigned short v) {return _mm_set1_epi16(static_cast<short>(v));}
+inline __m128i sse2_set1(unsigned int v) {return _mm_set1_epi32(static_cast<int>(v));}
+inline __m128i sse2_set1(unsigned long v) {return _mm_set1_epi64x(static_cast<long long>(v));}
+inline __m128i sse2_set1(unsigned long long v) {return _mm_set1_epi64x(static_cast<long long>(v));}
+
+//the last argument only selects the lane width
+inline __m128i sse2_cmpeq(__m128i a,__m128i b,unsigned char) {return _mm_cmpeq_epi8(a,b);}
+inline __m128i sse2_cmpeq(__m128i a,__m128i b,unsigned short) {return _mm_cmpeq_epi16(a,b);}
+inline __m128i sse2_cmpeq(__m128i a,__m128i b,unsigned int) {return _mm_cmpeq_epi32(a,b);}
+
+//no 64-bit compare before SSE4.1:both 32-bit halves must be equal
+inline __m128i sse2_cmpeq(__m128i a,__m128i b,unsigned long long)
+{
+    __m128i c=_mm_cmpeq_epi32(a,b);
+    return _mm_and_si128(c,_mm_shuffle_epi32(c,_MM_SHUFFLE(2,3,0,1)));
+}
+
+inline __m128i sse2_cmpeq(__m128i a,__m128i b,unsigned long)
+{
+    return sse2_cmpeq(a,b,static_cast<unsigned long long>(0));
+}
+
+const unsigned sse2_full_mask=0xffff;
+
+
+//AVX2:32 bytes per step
+SSTL_TARGET_AVX2 inline __m256i avx2_load(const void* p) {return _mm256_loadu_si256(static_cast<const __m256i*>(p));}
+
+SSTL_TARGET_AVX2 inline unsigned avx2_movemask(__m256i v) {return static_cast<unsigned>(_mm256_movemask_epi8(v));}
+
+SSTL_TARGET_AVX2 inline __m256i avx2_set1(unsigned char v) {return _mm256_set1_epi8(static_cast<char>(v));}
+SSTL_TARGET_AVX2 inline __m256i avx2_set1(unsigned short v) {return _mm256_set1_epi16(static_cast<short>(v));}
+SSTL_TARGET_AVX2 inline __m256i avx2_set1(unsigned int v) {return _mm256_set1_epi32(static_cast<int>(v));}
+SSTL_TARGET_AVX2 inline __m256i avx2_set1(unsigned long v) {return _mm256_set1_epi64x(static_cast<long long>(v));}
+SSTL_TARGET_AVX2 inline __m256i avx2_set1(unsigned long long v) {return _mm256_set1_epi64x(static_cast<long long>(v));}
+
+SSTL_TARGET_AVX2 inline __m256i avx2_cmpeq(__m256i a,__m256i b,unsigned char) {return _mm256_cmpeq_epi8(a,b);}
+SSTL_TARGET_AVX2 inline __m256i avx2_cmpeq(__m256i a,__m256i b,unsigned short) {return _mm256_cmpeq_epi16(a,b);}
+SSTL_TARGET_AVX2 inline __m256i avx2_cmpeq(__m256i a,__m256i b,unsigned int) {return _mm256_cmpeq_epi32(a,b);}
+SSTL_TARGET_AVX2 inline __m256i avx2_cmpeq(__m256i a,__m256i b,unsigned long) {return _mm256_cmpeq_epi64(a,b);}
+SSTL_TARGET_AVX2 inline __m256i avx2_cmpeq(__m256i a,__m256i b,unsigned long long) {return _mm256_cmpeq_epi64(a,b);}
+
+const unsigned avx2_full_mask=0xffffffff;
+
+
+//the kernels are the same for both instruction sets,only the prefix,the vector
+//width and the target attribute change.the movemask has one bit per byte,so a
+//lane of sizeof(U) bytes owns sizeof(U) bits.
+#define SSTL_SCAN_KERNELS(ISA,ATTR,WIDTH)                                       \
+                                                                                \
+template <class U>                                                              \
+ATTR size_t ISA##_find(const U* p,size_t n,U value)                             \
+{                                                                               \
+    const size_t step=WIDTH/sizeof(U);                                          \
+    auto v=ISA##_set1(value);                                                   \
+    size_t i=0;                                                                 \
+    for(;i+step<=n;i+=step){                                                    \
+        unsigned mask=ISA##_movemask(ISA##_cmpeq(ISA##_load(p+i),v,U()));       \
+        if(mask)                                                                \
+            return i+__builtin_ctz(mask)/sizeof(U);                             \
+    }                                                                           \
+    return scalar_find(p,i,n,value);                                            \
+}                                                                               \
+                                                                                \
+template <class U>                                                              \
+ATTR size_t ISA##_count(const U* p,size_t n,U value)                            \
+{                                                                               \
+    const size_t step=WIDTH/sizeof(U);                                          \
+    auto v=ISA##_set1(value);                                                   \
+    size_t bits=0;                                                              \
+    size_t i=0;                                                                 \
+    for(;i+step<=n;i+=step)                                                     \
+        bits+=__builtin_popcount(ISA##_movemask(ISA##_cmpeq(ISA##_load(p+i),v,U()))); \
+    return bits/sizeof(U)+scalar_count(p,i,n,value);                            \
+}                                                                               \
+                                                                                \
+template <class U>                                                              \
+ATTR size_t ISA##_mismatch(const U* a,const U* b,size_t n)                      \
+{                                                                               \
+    const size_t step=WIDTH/sizeof(U);                                          \
+    size_t i=0;                                                                 \
+    for(;i+step<=n;i+=step){                                                    \
+        unsigned mask=ISA##_movemask(ISA##_cmpeq(ISA##_load(a+i),ISA##_load(b+i),U())); \
+        if(mask!=ISA##_full_mask)                                               \
+            return i+__builtin_ctz(~mask)/sizeof(U);                            \
+    }                                                                           \
+    return scalar_mismatch(a,b,i,n);                                            \
+}                                                                               \
+                                                                                \
+template <class U>                                                              \
+ATTR size_t ISA##_adjacent_find(const U* p,size_t n)                            \
+{                                                                               \
+    const size_t step=WIDTH/sizeof(U);                                          \
+    size_t i=0;                                                                 \
+    for(;i+step<n;i+=step){                                                     \
+        unsigned mask=ISA##_movemask(ISA##_cmpeq(ISA##_load(p+i),ISA##_load(p+i+1),U())); \
+        if(mask)                                                                \
+            return i+__builtin_ctz(mask)/sizeof(U);                             \
+    }                                                                           \
+    return scalar_adjacent_find(p,i,n);                                         \
+}
+
+SSTL_SCAN_KERNELS(sse2,inline,16)
+SSTL_SCAN_KERNELS(avx2,SSTL_TARGET_AVX2 inline,32)
+
+#undef SSTL_SCAN_KERNELS
+
+#endif // SSTL_SIMD
+
+
+//entry points:U is an unsigned integral type,n the element count.
+//find,mismatch and adjacent_find return an index,n if nothing is found.
+template <class U>
+size_t simd_find(const U* p,size_t n,U value)
+{
+#if SSTL_SIMD
+    return simd_has_avx2() ? avx2_find(p,n,value) : sse2_find(p,n,value);
+#else
+    return scalar_find(p,0,n,value);
+#endif
+}
+
+template <class U>
+size_t simd_count(const U* p,size_t n,U value)
+{
+#if SSTL_SIMD
+    return simd_has_avx2() ? avx2_count(p,n,value) : sse2_count(p,n,value);
+#else
+    return scalar_count(p,0,n,value);
+#endif
+}
+
+template <class U>
+size_t simd_mismatch(const U* a,const U* b,size_t n)
+{
+#if SSTL_SIMD
+    return simd_has_avx2() ? avx2_mismatch(a,b,n) : sse2_mismatch(a,b,n);
+#else
+    return scalar_mismatch(a,b,0,n);
+#endif
+}
+
+template <class U>
+size_t simd_adjacent_find(const U* p,size_t n)
+{
+#if SSTL_SIMD
+    return simd_has_avx2() ? avx2_adjacent_find(p,n) : sse2_adjacent_find(p,n);
+#else
+    return scalar_adjacent_find(p,0,n);
+#endif
+}
+
+//memcmp is already vectorized by the C library
+template <class U>
+bool simd_equal(const U* a,const U* b,size_t n)
+{
+    return n==0 || std::memcmp(a,b,n*sizeof(U))==0;
+}
+
+
+//min and max
+//raw pointers to integral(bool aside),float and double elements.
+//the kernels pick their instructions by the fixed-width lane type of the element.
+template <class Iterator>
+struct is_minmax_pointer
+{
+    static constexpr bool value=false;
+};
+
+template <class T>
+struct is_minmax_pointer<T*>
+{
+    typedef typename std::remove_cv<T>::type type;
+    static constexpr bool value=is_scan_pointer<T*>::value
+                                || std::is_same<type,float>::value || std::is_same<type,double>::value;
+};
+
+template <size_t Size,bool Signed>
+struct minmax_int_lane;
+
+template <> struct minmax_int_lane<1,true> {typedef int8_t type;};
+template <> struct minmax_int_lane<1,false> {typedef uint8_t type;};
+template <> struct minmax_int_lane<2,true> {typedef int16_t type;};
+template <> struct minmax_int_lane<2,false> {typedef uint16_t type;};
+template <> struct minmax_int_lane<4,true> {typedef int32_t type;};
+template <> struct minmax_int_lane<4,false> {typedef uint32_t type;};
+template <> struct minmax_int_lane<8,true> {typedef int64_t type;};
+template <> struct minmax_int_lane<8,false> {typedef uint64_t type;};
+
+template <class T,bool Integral=std::is_integral<T>::value>
+struct minmax_lane
+{
+    typedef typename minmax_int_lane<sizeof(T),std::is_signed<T>::value>::type type;
+};
+
+template <class T>
+struct minmax_lane<T,false>
+{
+    typedef T type;
+};
+
+
+//scalar kernels,p[0] is not a NaN and n>0.
+//a NaN never compares less or greater,so it is skipped like the generic loops do.
+template <class T>
+size_t scalar_min_element(const T* p,size_t n)
+{
+    size_t result=0;
+    for(size_t i=1;i<n;++i)
+        if(p[i]<p[result])
+            result=i;
+    return result;
+}
+
+template <class T>
+size_t scalar_max_element(const T* p,size_t n)
+{
+    size_t result=0;
+    for(size_t i=1;i<n;++i)
+        if(p[result]<p[i])
+            result=i;
+    return result;
+}
+
+
+#if SSTL_SIMD
+
+//SSE2 has native min/max only for unsigned bytes and signed shorts.
+//the rest select on a compare;unsigned lanes flip the sign bit to compare signed.
+//there is no 64-bit compare,such elements stay scalar without AVX2.
+inline __m128 sse2_load(const void* p,float) {return _mm_loadu_ps(static_cast<const float*>(p));}
+inline __m128d sse2_load(const void* p,double) {return _mm_loadu_pd(static_cast<const double*>(p));}
+template <class L>
+inline __m128i sse2_load(const void* p,L) {return sse2_load(p);}
+
+inline void sse2_store(void* p,__m128 v) {_mm_storeu_ps(static_cast<float*>(p),v);}
+inline void sse2_store(void* p,__m128d v) {_mm_storeu_pd(static_cast<double*>(p),v);}
+inline void sse2_store(void* p,__m128i v) {_mm_storeu_si128(static_cast<__m128i*>(p),v);}
+
+inline __m128 sse2_set1(float v) {return _mm_set1_ps(v);}
+inline __m128d sse2_set1(double v) {return _mm_set1_pd(v);}
+inline __m128i sse2_set1(int8_t v) {return _mm_set1_epi8(v);}
+inline __m128i sse2_set1(int16_t v) {return _mm_set1_epi16(v);}
+inline __m128i sse2_set1(int32_t v) {return _mm_set1_epi32(v);}
+
+//gt?b:a
+inline __m128i sse2_select(__m128i gt,__m128i a,__m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(gt,b),_mm_andnot_si128(gt,a));
+}
+
+inline __m128i sse2_flip(__m128i v,uint16_t) {return _mm_xor_si128(v,_mm_set1_epi16(-0x8000));}
+inline __m128i sse2_flip(__m128i v,uint32_t) {return _mm_xor_si128(v,_mm_set1_epi32(INT32_MIN));}
+
+//min(x,acc) keeps acc when x is a NaN
+inline __m128 sse2_min(__m128 x,__m128 acc,float) {return _mm_min_ps(x,acc);}
+inline __m128 sse2_max(__m128 x,__m128 acc,float) {return _mm_max_ps(x,acc);}
+inline __m128d sse2_min(__m128d x,__m128d acc,double) {return _mm_min_pd(x,acc);}
+inline __m128d sse2_max(__m128d x,__m128d acc,double) {return _mm_max_pd(x,acc);}
+inline __m128i sse2_min(__m128i x,__m128i acc,int8_t) {return sse2_select(_mm_cmpgt_epi8(x,acc),x,acc);}
+inline __m128i sse2_max(__m128i x,__m128i acc,int8_t) {return sse2_select(_mm_cmpgt_epi8(acc,x),x,acc);}
+inline __m128i sse2_min(__m128i x,__m128i acc,uint8_t) {return _mm_min_epu8(x,acc);}
+inline __m128i sse2_max(__m128i x,__m128i acc,uint8_t) {return _mm_max_epu8(x,acc);}
+inline __m128i sse2_min(__m128i x,__m128i acc,int16_t) {return _mm_min_epi16(x,acc);}
+inline __m128i sse2_max(__m128i x,__m128i acc,int16_t) {return _mm_max_epi16(x,acc);}
+inline __m128i sse2_min(__m128i x,__m128i acc,int32_t) {return sse2_select(_mm_cmpgt_epi32(x,acc),x,acc);}
+inline __m128i sse2_max(__m128i x,__m128i acc,int32_t) {return sse2_select(_mm_cmpgt_epi32(acc,x),x,acc);}
+
+inline __m128i sse2_min(__m128i x,__m128i acc,uint16_t)
+{
+    return sse2_flip(_mm_min_epi16(sse2_flip(x,uint16_t()),sse2_flip(acc,uint16_t())),uint16_t());
+}
+
+inline __m128i sse2_max(__m128i x,__m128i acc,uint16_t)
+{
+    return sse2_flip(_mm_max_epi16(sse2_flip(x,uint16_t()),sse2_flip(acc,uint16_t())),uint16_t());
+}
+
+inline __m128i sse2_min(__m128i x,__m128i acc,uint32_t)
+{
+    return sse2_select(_mm_cmpgt_epi32(sse2_flip(x,uint32_t()),sse2_flip(acc,uint32_t())),x,acc);
+}
+
+inline __m128i sse2_max(__m128i x,__m128i acc,uint32_t)
+{
+    return sse2_select(_mm_cmpgt_epi32(sse2_flip(acc,uint32_t()),sse2_flip(x,uint32_t())),x,acc);
+}
+
+template <class L>
+struct sse2_has_minmax
+{
+    static constexpr bool value=sizeof(L)<8 || std::is_floating_point<L>::value;
+};
+
+
+//AVX2 has them all but 64-bit,which selects on a compare
+SSTL_TARGET_AVX2 inline __m256 avx2_load(const void* p,float) {return _mm256_loadu_ps(static_cast<const float*>(p));}
+SSTL_TARGET_AVX2 inline __m256d avx2_load(const void* p,double) {return _mm256_loadu_pd(static_cast<const double*>(p));}
+template <class L>
+SSTL_TARGET_AVX2 inline __m256i avx2_load(const void* p,L) {return avx2_load(p);}
+
+SSTL_TARGET_AVX2 inline void avx2_store(void* p,__m256 v) {_mm256_storeu_ps(static_cast<float*>(p),v);}
+SSTL_TARGET_AVX2 inline void avx2_store(void* p,__m256d v) {_mm256_storeu_pd(static_cast<double*>(p),v);}
+SSTL_TARGET_AVX2 inline void avx2_store(void* p,__m256i v) {_mm256_storeu_si256(static_cast<__m256i*>(p),v);}
+
+SSTL_TARGET_AVX2 inline __m256 avx2_set1(float v) {return _mm256_set1_ps(v);}
+SSTL_TARGET_AVX2 inline __m256d avx2_set1(double v) {return _mm256_set1_pd(v);}
+SSTL_TARGET_AVX2 inline __m256i avx2_set1(int8_t v) {return _mm256_set1_epi8(v);}
+SSTL_TARGET_AVX2 inline __m256i avx2_set1(int16_t v) {return _mm256_set1_epi16(v);}
+SSTL_TARGET_AVX2 inline __m256i avx2_set1(int32_t v) {return _mm256_set1_epi32(v);}
+SSTL_TARGET_AVX2 inline __m256i avx2_set1(int64_t v) {return _mm256_set1_epi64x(v);}
+
+SSTL_TARGET_AVX2 inline __m256i avx2_flip(__m256i v,uint64_t) {return _mm256_xor_si256(v,_mm256_set1_epi64x(INT64_MIN));}
+
+SSTL_TARGET_AVX2 inline __m256 avx2_min(__m256 x,__m256 acc,float) {return _mm256_min_ps(x,acc);}
+SSTL_TARGET_AVX2 inline __m256 avx2_max(__m256 x,__m256 acc,float) {return _mm256_max_ps(x,acc);}
+SSTL_TARGET_AVX2 inline __m256d avx2_min(__m256d x,__m256d acc,double) {return _mm256_min_pd(x,acc);}
+SSTL_TARGET_AVX2 inline __m256d avx2_max(__m256d x,__m256d acc,double) {return _mm256_max_pd(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_min(__m256i x,__m256i acc,int8_t) {return _mm256_min_epi8(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_max(__m256i x,__m256i acc,int8_t) {return _mm256_max_epi8(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_min(__m256i x,__m256i acc,uint8_t) {return _mm256_min_epu8(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_max(__m256i x,__m256i acc,uint8_t) {return _mm256_max_epu8(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_min(__m256i x,__m256i acc,int16_t) {return _mm256_min_epi16(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_max(__m256i x,__m256i acc,int16_t) {return _mm256_max_epi16(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_min(__m256i x,__m256i acc,uint16_t) {return _mm256_min_epu16(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_max(__m256i x,__m256i acc,uint16_t) {return _mm256_max_epu16(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_min(__m256i x,__m256i acc,int32_t) {return _mm256_min_epi32(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_max(__m256i x,__m256i acc,int32_t) {return _mm256_max_epi32(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_min(__m256i x,__m256i acc,uint32_t) {return _mm256_min_epu32(x,acc);}
+SSTL_TARGET_AVX2 inline __m256i avx2_max(__m256i x,__m256i acc,uint32_t) {return _mm256_max_epu32(x,acc);}
+
+SSTL_TARGET_AVX2 inline __m256i avx2_min(__m256i x,__m256i acc,int64_t)
+{
+    return _mm256_blendv_epi8(acc,x,_mm256_cmpgt_epi64(acc,x));
+}
+
+SSTL_TARGET_AVX2 inline __m256i avx2_max(__m256i x,__m256i acc,int64_t)
+{
+    return _mm256_blendv_epi8(acc,x,_mm256_cmpgt_epi64(x,acc));
+}
+
+SSTL_TARGET_AVX2 inline __m256i avx2_min(__m256i x,__m256i acc,uint64_t)
+{
+    return _mm256_blendv_epi8(acc,x,_mm256_cmpgt_epi64(avx2_flip(acc,uint64_t()),avx2_flip(x,uint64_t())));
+}
+
+SSTL_TARGET_AVX2 inline __m256i avx2_max(__m256i x,__m256i acc,uint64_t)
+{
+    return _mm256_blendv_epi8(acc,x,_mm256_cmpgt_epi64(avx2_flip(x,uint64_t()),avx2_flip(acc,uint64_t())));
+}
+
+
+//the range is cut into blocks of minmax_block_vectors vectors.each block is
+//reduced in registers,starting from the best value so far;only a block that
+//improves on it is remembered.the remembered block is rescanned for the position
+//at the end,so memory is read once plus one block.
+const size_t minmax_block_vectors=64;
+
+//the largest is the last one:a block that only ties the best so far still wins,
+//so its reduction starts from the lowest value instead,never from the best.
+template <class T>
+T minmax_lowest()
+{
+    return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                                : std::numeric_limits<T>::lowest();
+}
+
+#define SSTL_MINMAX_KERNELS(ISA,ATTR,WIDTH)                                     \
+                                                                                \
+template <class T,class L>                                                      \
+ATTR size_t ISA##_min_element(const T* p,size_t n,L)                            \
+{                                                                               \
+    const size_t step=WIDTH/sizeof(T);                                          \
+    const size_t block=step*minmax_block_vectors;                               \
+    T best=p[0];                                                                \
+    size_t best_block=n;                                                        \
+    size_t i=0;                                                                 \
+    for(;i+block<=n;i+=block){                                                  \
+        auto acc=ISA##_set1(static_cast<L>(best));                              \
+        for(size_t j=i;j<i+block;j+=step)                                       \
+            acc=ISA##_min(ISA##_load(p+j,L()),acc,L());                         \
+        L lanes[WIDTH/sizeof(L)];                                               \
+        ISA##_store(lanes,acc);                                                 \
+        T m=best;                                                               \
+        for(size_t k=0;k<step;++k)                                              \
+            if(lanes[k]<m) m=lanes[k];                                          \
+        if(m<best){                                                             \
+            best=m;                                                             \
+            best_block=i;                                                       \
+        }                                                                       \
+    }                                                                           \
+    size_t result=0;                                                            \
+    if(best_block!=n)                                                           \
+        for(result=best_block;!(p[result]==best);++result)                      \
+            ;                                                                   \
+    for(;i<n;++i)                                                               \
+        if(p[i]<p[result]) result=i;                                            \
+    return result;                                                              \
+}                                                                               \
+                                                                                \
+template <class T,class L>                                                      \
+ATTR size_t ISA##_max_element(const T* p,size_t n,L)                            \
+{                                                                               \
+    const size_t step=WIDTH/sizeof(T);                                          \
+    const size_t block=step*minmax_block_vectors;                               \
+    T best=p[0];                                                                \
+    size_t best_block=n;                                                        \
+    size_t i=0;                                                                 \
+    for(;i+block<=n;i+=block){                                                  \
+        auto acc=ISA##_set1(static_cast<L>(best));                              \
+        for(size_t j=i;j<i+block;j+=step)                                       \
+            acc=ISA##_max(ISA##_load(p+j,L()),acc,L());                         \
+        L lanes[WIDTH/sizeof(L)];                                               \
+        ISA##_store(lanes,acc);                                                 \
+        T m=best;                                                               \
+        for(size_t k=0;k<step;++k)                                              \
+            if(m<lanes[k]) m=lanes[k];                                          \
+        if(best<m){                                                             \
+            best=m;                                                             \
+            best_block=i;                                                       \
+        }                                                                       \
+    }                                                                           \
+    size_t result=0;                                                            \
+    if(best_block!=n)                                                           \
+        for(result=best_block;!(p[result]==best);++result)                      \
+            ;                                                                   \
+    for(;i<n;++i)                                                               \
+        if(p[result]<p[i]) result=i;                                            \
+    return result;                                                              \
+}                                                                               \
+                                                                                \
+/*first smallest,last largest*/                                                 \
+template <class T,class L>                                                      \
+ATTR void ISA##_minmax_element(const T* p,size_t n,size_t& min,size_t& max,L)   \
+{                                                                               \
+    const size_t step=WIDTH/sizeof(T);                                          \
+    const size_t block=step*minmax_block_vectors;                               \
+    T low=p[0],high=p[0];                                                       \
+    size_t low_block=n,high_block=n;                                            \
+    size_t i=0;                                                                 \
+    for(;i+block<=n;i+=block){                                                  \
+        auto low_acc=ISA##_set1(static_cast<L>(low));                           \
+        auto high_acc=ISA##_set1(static_cast<L>(minmax_lowest<T>()));          \
+        for(size_t j=i;j<i+block;j+=step){                                      \
+            auto x=ISA##_load(p+j,L());                                         \
+            low_acc=ISA##_min(x,low_acc,L());                                   \
+            high_acc=ISA##_max(x,high_acc,L());                                 \
+        }                                                                       \
+        L lanes[WIDTH/sizeof(L)];                                               \
+        ISA##_store(lanes,low_acc);                                             \
+        T m=low;                                                                \
+        for(size_t k=0;k<step;++k)                                              \
+            if(lanes[k]<m) m=lanes[k];                                          \
+        if(m<low){                                                              \
+            low=m;                                                              \
+            low_block=i;                                                        \
+        }                                                                       \
+        ISA##_store(lanes,high_acc);                                            \
+        m=minmax_lowest<T>();                                                   \
+        for(size_t k=0;k<step;++k)                                              \
+            if(m<lanes[k]) m=lanes[k];                                          \
+        if(!(m<high)){                                                          \
+            high=m;                                                             \
+            high_block=i;                                                       \
+        }                                                                       \
+    }                                                                           \
+    min=0;                                                                      \
+    if(low_block!=n)                                                            \
+        for(min=low_block;!(p[min]==low);++min)                                 \
+            ;                                                                   \
+    max=0;                                                                      \
+    if(high_block!=n)                                                           \
+        for(max=high_block+block-1;!(p[max]==high);--max)                       \
+            ;                                                                   \
+    for(;i<n;++i){                                                              \
+        if(p[i]<p[min]) min=i;                                                  \
+        if(p[max]<=p[i]) max=i;                                                 \
+    }                                                                           \
+}
+
+SSTL_MINMAX_KERNELS(sse2,inline,16)
+SSTL_MINMAX_KERNELS(avx2,SSTL_TARGET_AVX2 inline,32)
+
+#undef SSTL_MINMAX_KERNELS
+
+
+//SSE2 lacks the lane type:scalar
+template <class T,class L>
+size_t sse2_min_element(const T* p,size_t n,L,false_type) {return scalar_min_element(p,n);}
+
+template <class T,class L>
+size_t sse2_min_element(const T* p,size_t n,L,true_type) {return sse2_min_element(p,n,L());}
+
+template <class T,class L>
+size_t sse2_max_element(const T* p,size_t n,L,false_type) {return scalar_max_element(p,n);}
+
+template <class T,class L>
+size_t sse2_max_element(const T* p,size_t n,L,true_type) {return sse2_max_element(p,n,L());}
+
+template <class T,class L>
+void sse2_minmax_element(const T* p,size_t n,size_t& min,size_t& max,L,false_type)
+{
+    min=scalar_min_element(p,n);
+    max=0;
+    for(size_t i=1;i<n;++i)
+        if(p[max]<=p[i]) max=i;
+}
+
+template <class T,class L>
+void sse2_minmax_element(const T* p,size_t n,size_t& min,size_t& max,L,true_type)
+{
+    sse2_minmax_element(p,n,min,max,L());
+}
+
+#undef SSTL_TARGET_AVX2
+
+#endif // SSTL_SIMD
+
+
+//entry points:T is the element type(no cv),n>0 and p[0] is not a NaN.
+//the results are indices.
+template <class T>
+size_t simd_min_element(const T* p,size_t n)
+{
+#if SSTL_SIMD
+    typedef typename minmax_lane<T>::type L;
+    return simd_has_avx2() ? avx2_min_element(p,n,L())
+                           : sse2_min_element(p,n,L(),typename bool_tag<sse2_has_minmax<L>::value>::type());
+#else
+    return scalar_min_element(p,n);
+#endif
+}
+
+template <class T>
+size_t simd_max_element(const T* p,size_t n)
+{
+#if SSTL_SIMD
+    typedef typename minmax_lane<T>::type L;
+    return simd_has_avx2() ? avx2_max_element(p,n,L())
+                           : sse2_max_element(p,n,L(),typename bool_tag<sse2_has_minmax<L>::value>::type());
+#else
+    return scalar_max_element(p,n);
+#endif
+}
+
+//the first smallest and the last largest,like minmax_element
+template <class T>
+void simd_minmax_element(const T* p,size_t n,size_t& min,size_t& max)
+{
+#if SSTL_SIMD
+    typedef typename minmax_lane<T>::type L;
+    if(simd_has_avx2())
+        avx2_minmax_element(p,n,min,max,L());
+    else
+        sse2_minmax_element(p,n,min,max,L(),typename bool_tag<sse2_has_minmax<L>::value>::type());
+#else
+    min=scalar_min_element(p,n);
+    max=0;
+    for(size_t i=1;i<n;++i)
+        if(p[max]<=p[i]) max=i;
+#endif
+}
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // SIMD_H_INCLUDED
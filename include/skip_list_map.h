@@ -0,0 +1,469 @@
+#ifndef SKIP_LIST_MAP_H_INCLUDED
+#define SKIP_LIST_MAP_H_INCLUDED
+
+#include "sstl.h"
+#include "allocator.h"
+#include "iterator_traits.h"
+#include "function.h"
+#include "utilities.h"
+#include "epoch.h"
+
+#include <atomic>
+#include <new>
+#include <initializer_list>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//skip list node with a tower of next pointers,allocated in one block.
+//the low bit of next[i] marks the node as deleted at level i.
+template <class Value>
+struct skip_list_node
+{
+    Value value;
+    std::atomic<int> refs;      //the list and the inserting thread
+    int level;
+    std::atomic<uintptr_t> next[1];
+};
+
+
+template <class Value>
+struct skip_list_iterator
+{
+    //typedefs
+    typedef forward_iterator_tag    iterator_category;
+    typedef Value                   value_type;
+    typedef const Value&            reference;
+    typedef const Value*            pointer;
+    typedef ptrdiff_t               difference_type;
+
+    typedef skip_list_iterator          iterator;
+    typedef skip_list_node<Value>*      link_type;
+
+
+    //wrapped pointer
+    link_type _node;
+
+
+    //constructors
+    skip_list_iterator()=default;
+
+    skip_list_iterator(link_type node):_node(node){}
+
+
+    //data access
+    reference operator*() const {return _node->value;}
+
+    pointer operator->() const {return &(operator*());}
+
+
+    //arithmetic operations
+    //deleted nodes still point into the list,so a scan can always go on.
+    iterator& operator++()
+    {
+        _node=reinterpret_cast<link_type>(_node->next[0].load()&~uintptr_t(1));
+        while(_node && (_node->next[0].load()&1))
+            _node=reinterpret_cast<link_type>(_node->next[0].load()&~uintptr_t(1));
+        return *this;
+    }
+
+    iterator operator++(int)
+    {
+        iterator tmp=*this;
+        ++*this;
+        return tmp;
+    }
+
+
+    //relational operations
+    bool operator==(const iterator& iter) const {return _node==iter._node;}
+
+    bool operator!=(const iterator& iter) const {return _node!=iter._node;}
+
+};
+
+
+//lock-free ordered map(Fraser/Herlihy skip list),the api follows map.h.
+//any number of threads may insert,erase,look up and scan at the same time,
+//a scan keeps going while writers change the list around it.
+//
+//nodes are freed through epoch.h:iterators and references stay valid while
+//the thread holds an epoch_guard.the member functions guard themselves,so
+//single lookups need nothing more;hold a guard around any use of an iterator:
+//  {
+//      epoch_guard guard;
+//      for(iter=m.lower_bound(a);iter!=m.end() && iter->first<b;++iter) ...
+//  }
+//elements are immutable once inserted(erase and insert again to change one).
+//clear,swap,assignment and destruction must not race with other operations.
+template <class Key,class Value,class Compare=less<Key>,class Alloc=malloc_alloc>
+class skip_list_map
+{
+public:
+
+    //typedefs
+    typedef Key                         key_type;
+    typedef Value                       data_type;
+    typedef Value                       mapped_type;
+    typedef pair<key_type,data_type>    value_type;
+    typedef Compare                     key_compare;
+
+    typedef skip_list_iterator<value_type>  iterator;
+    typedef iterator                        const_iterator;
+    typedef const value_type*               pointer;
+    typedef const value_type*               const_pointer;
+    typedef const value_type&               reference;
+    typedef const value_type&               const_reference;
+    typedef size_t                          size_type;
+    typedef ptrdiff_t                       difference_type;
+
+    //towers are 1..max_level high,each level keeps a quarter of the one below
+    static constexpr int max_level=20;
+
+
+    //constructors
+    skip_list_map():_size(0),_comp(key_compare()) {_head=create_head();}
+
+    explicit skip_list_map(const key_compare& comp):_size(0),_comp(comp) {_head=create_head();}
+
+    template <class InputIterator>
+    skip_list_map(InputIterator begin,InputIterator end,const key_compare& comp=key_compare()):_size(0),_comp(comp)
+    {
+        _head=create_head();
+        insert(begin,end);
+    }
+
+    skip_list_map(std::initializer_list<value_type> il):_size(0),_comp(key_compare())
+    {
+        _head=create_head();
+        insert(il.begin(),il.end());
+    }
+
+    skip_list_map(const skip_list_map& m):_size(0),_comp(m._comp)
+    {
+        _head=create_head();
+        epoch_guard guard;
+        insert(m.begin(),m.end());
+    }
+
+
+    //assignment
+    skip_list_map& operator=(const skip_list_map& m)
+    {
+        if(this==&m) return *this;
+        clear();
+        _comp=m._comp;
+        epoch_guard guard;
+        insert(m.begin(),m.end());
+        return *this;
+    }
+
+
+    //iterators
+    iterator begin() const
+    {
+        epoch_guard guard;
+        return ++iterator(_head);
+    }
+
+    iterator end() const {return iterator(nullptr);}
+
+    const_iterator cbegin() const {return begin();}
+
+    const_iterator cend() const {return end();}
+
+
+    //swap
+    void swap(skip_list_map& m)
+    {
+        link_type tmp_head=_head;_head=m._head;m._head=tmp_head;
+        size_type tmp_size=_size.load();_size.store(m._size.load());m._size.store(tmp_size);
+        key_compare tmp_comp=_comp;_comp=m._comp;m._comp=tmp_comp;
+    }
+
+
+    //size(exact only when no writer is running)
+    bool empty() const {return begin()==end();}
+
+    size_type size() const {return _size.load();}
+
+
+    //insert
+    pair<iterator,bool> insert(const_reference value)
+    {
+        epoch_guard guard;
+        const key_type& k=value.first;
+        link_type preds[max_level];
+        link_type succs[max_level];
+        link_type p=nullptr;
+
+        for(;;){
+            if(search(k,preds,succs)){
+                if(p) destroy_node(p);
+                return {iterator(succs[0]),false};
+            }
+            if(!p)
+                p=create_node(value,random_level());
+            for(int i=0;i<p->level;++i)
+                p->next[i].store(to_word(succs[i]),std::memory_order_relaxed);
+
+            uintptr_t expected=to_word(succs[0]);
+            if(preds[0]->next[0].compare_exchange_strong(expected,to_word(p)))
+                break;
+        }
+        ++_size;
+
+        //the node is in the list now,link the upper levels
+        for(int i=1;i<p->level;++i){
+            for(;;){
+                uintptr_t expected=to_word(succs[i]);
+                if(preds[i]->next[i].compare_exchange_strong(expected,to_word(p)))
+                    break;
+                search(k,preds,succs);
+                if(succs[0]!=p) goto done;  //already erased
+                uintptr_t old=p->next[i].load();
+                if((old&1) || !p->next[i].compare_exchange_strong(old,to_word(succs[i])))
+                    goto done;              //being erased
+            }
+        }
+    done:
+        //an erase that ran while we linked may have missed a level
+        if(p->next[0].load()&1)
+            search(k,preds,succs);
+        release_node(p);
+        return {iterator(p),true};
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator begin,InputIterator end)
+    {
+        for(;begin!=end;++begin)
+            insert(*begin);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        insert(il.begin(),il.end());
+    }
+
+
+    //erase
+    size_type erase(const key_type& k)
+    {
+        epoch_guard guard;
+        link_type preds[max_level];
+        link_type succs[max_level];
+        if(!search(k,preds,succs)) return 0;
+
+        //mark the tower top down,whoever marks level 0 owns the erase
+        link_type p=succs[0];
+        for(int i=p->level-1;i>0;--i){
+            uintptr_t next=p->next[i].load();
+            while(!(next&1))
+                p->next[i].compare_exchange_weak(next,next|1);
+        }
+        uintptr_t next=p->next[0].load();
+        for(;;){
+            if(next&1) return 0;
+            if(p->next[0].compare_exchange_weak(next,next|1))
+                break;
+        }
+        --_size;
+        search(k,preds,succs);  //unlink every level
+        release_node(p);
+        return 1;
+    }
+
+    void erase(iterator tar) {erase(tar->first);}
+
+    //not safe against concurrent writers
+    void clear()
+    {
+        link_type p=to_link(_head->next[0].load());
+        while(p){
+            link_type next=to_link(p->next[0].load());
+            destroy_node(p);
+            p=next;
+        }
+        for(int i=0;i<max_level;++i)
+            _head->next[i].store(0);
+        _size.store(0);
+    }
+
+
+    //find
+    iterator find(const key_type& k) const
+    {
+        epoch_guard guard;
+        iterator iter=lower_bound(k);
+        return (iter!=end() && !_comp(k,iter->first)) ? iter : end();
+    }
+
+    size_type count(const key_type& k) const {return find(k)==end() ? 0 : 1;}
+
+    bool contains(const key_type& k) const {return find(k)!=end();}
+
+    //lock-free:skips deleted nodes without helping to unlink them
+    iterator lower_bound(const key_type& k) const
+    {
+        epoch_guard guard;
+        link_type pred=_head;
+        link_type cur=nullptr;
+        for(int i=max_level-1;i>=0;--i){
+            cur=to_link(pred->next[i].load());
+            for(;;){
+                while(cur && (cur->next[i].load()&1))
+                    cur=to_link(cur->next[i].load());
+                if(cur && _comp(cur->value.first,k)){
+                    pred=cur;
+                    cur=to_link(cur->next[i].load());
+                }else
+                    break;
+            }
+        }
+        return iterator(cur);
+    }
+
+    iterator upper_bound(const key_type& k) const
+    {
+        epoch_guard guard;
+        iterator iter=lower_bound(k);
+        if(iter!=end() && !_comp(k,iter->first))
+            ++iter;
+        return iter;
+    }
+
+    pair<iterator,iterator> equal_range(const key_type& k) const
+    {
+        epoch_guard guard;
+        iterator first=lower_bound(k);
+        iterator last=first;
+        if(last!=end() && !_comp(k,last->first))
+            ++last;
+        return {first,last};
+    }
+
+
+    //extra
+    key_compare key_comp() const {return _comp;}
+
+
+    //destructor
+    ~skip_list_map()
+    {
+        clear();
+        put_node(_head);
+    }
+
+private:
+    typedef skip_list_node<value_type>*     link_type;
+
+    link_type _head;                //tower of max_level,no value
+    std::atomic<size_type> _size;
+    key_compare _comp;
+
+
+    //marked words
+    static uintptr_t to_word(link_type p) {return reinterpret_cast<uintptr_t>(p);}
+
+    static link_type to_link(uintptr_t w) {return reinterpret_cast<link_type>(w&~uintptr_t(1));}
+
+
+    //allocate and deallocate
+    static size_t node_bytes(int level)
+    {
+        return sizeof(skip_list_node<value_type>)+(level-1)*sizeof(std::atomic<uintptr_t>);
+    }
+
+    static link_type get_node(int level)
+    {
+        link_type p=static_cast<link_type>(Alloc::allocate(node_bytes(level)));
+        for(int i=0;i<level;++i)
+            new(&p->next[i]) std::atomic<uintptr_t>(0);
+        new(&p->refs) std::atomic<int>(2);
+        p->level=level;
+        return p;
+    }
+
+    static void put_node(link_type p) {Alloc::deallocate(p);}
+
+
+    //create and destroy
+    static link_type create_node(const_reference value,int level)
+    {
+        link_type p=get_node(level);
+        construct(&p->value,value);
+        return p;
+    }
+
+    static void destroy_node(link_type p)
+    {
+        destroy(&p->value);
+        put_node(p);
+    }
+
+    static void destroy_retired(void* p) {destroy_node(static_cast<link_type>(p));}
+
+    static link_type create_head() {return get_node(max_level);}
+
+    //the last of the eraser and the inserter hands the node to the epoch domain
+    static void release_node(link_type p)
+    {
+        if(p->refs.fetch_sub(1)==1)
+            epoch_retire(p,&skip_list_map::destroy_retired);
+    }
+
+
+    static int random_level()
+    {
+        static thread_local unsigned long long state=0;
+        if(!state)
+            state=reinterpret_cast<uintptr_t>(&state)|1;
+        state^=state << 13;
+        state^=state >> 7;
+        state^=state << 17;
+        int level=1;
+        for(unsigned long long bits=state;(bits&3)==0 && level<max_level;bits>>=2)
+            ++level;
+        return level;
+    }
+
+
+    //fill preds/succs around k on every level,unlinking marked nodes on the way.
+    //returns true if an unmarked node with key k was found on level 0.
+    bool search(const key_type& k,link_type* preds,link_type* succs)
+    {
+    retry:
+        link_type pred=_head;
+        for(int i=max_level-1;i>=0;--i){
+            link_type cur=to_link(pred->next[i].load());
+            for(;;){
+                if(!cur) break;
+                uintptr_t next=cur->next[i].load();
+                while(next&1){
+                    uintptr_t expected=to_word(cur);
+                    if(!pred->next[i].compare_exchange_strong(expected,next&~uintptr_t(1)))
+                        goto retry;
+                    cur=to_link(next);
+                    if(!cur) break;
+                    next=cur->next[i].load();
+                }
+                if(cur && _comp(cur->value.first,k)){
+                    pred=cur;
+                    cur=to_link(next);
+                }else
+                    break;
+            }
+            preds[i]=pred;
+            succs[i]=cur;
+        }
+        return succs[0] && !_comp(k,succs[0]->value.first);
+    }
+
+};
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // SKIP_LIST_MAP_H_INCLUDED
@@ -0,0 +1,586 @@
+#ifndef THREAD_POOL_H_INCLUDED
+#define THREAD_POOL_H_INCLUDED
+
+#include "sstl.h"
+#include "vector.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+
+SSTL_NAMESPACE_BEGIN
+
+//a task is a function pointer and whatever the derived struct carries
+struct pool_task
+{
+    void (*execute)(pool_task*);
+};
+
+
+//Chase-Lev work-stealing deque of tasks.
+//the owner pushes and takes at the bottom(LIFO),thieves steal from the top(FIFO).
+//the ring doubles when full;old rings stay alive until the deque dies,since a
+//thief may still be reading one.all top/bottom accesses are seq_cst:the owner's
+//take and a thief's steal race on the last task through top.
+class work_stealing_deque
+{
+public:
+
+    work_stealing_deque():_top(0),_bottom(0),_ring(new ring(initial_capacity)){}
+
+    work_stealing_deque(const work_stealing_deque&)=delete;
+
+    work_stealing_deque& operator=(const work_stealing_deque&)=delete;
+
+
+    //owner only
+    void push(pool_task* task)
+    {
+        long b=_bottom.load(std::memory_order_relaxed);
+        long t=_top.load();
+        ring* r=_ring.load(std::memory_order_relaxed);
+        if(b-t>=static_cast<long>(r->capacity))
+            r=grow(r,t,b);
+        r->put(b,task);
+        _bottom.store(b+1);
+    }
+
+    //owner only,nullptr if empty
+    pool_task* take()
+    {
+        long b=_bottom.load(std::memory_order_relaxed)-1;
+        ring* r=_ring.load(std::memory_order_relaxed);
+        _bottom.store(b);
+        long t=_top.load();
+        if(t>b){
+            _bottom.store(b+1);
+            return nullptr;
+        }
+        pool_task* task=r->get(b);
+        if(t==b){
+            //last task:win it against the thieves
+            if(!_top.compare_exchange_strong(t,t+1))
+                task=nullptr;
+            _bottom.store(b+1);
+        }
+        return task;
+    }
+
+    //any thread,nullptr if empty or lost a race
+    pool_task* steal()
+    {
+        long t=_top.load();
+        long b=_bottom.load();
+        if(t>=b) return nullptr;
+        pool_task* task=_ring.load()->get(t);
+        if(!_top.compare_exchange_strong(t,t+1))
+            return nullptr;
+        return task;
+    }
+
+    bool empty() const {return _top.load()>=_bottom.load();}
+
+
+    ~work_stealing_deque()
+    {
+        delete _ring.load();
+        for(size_t i=0;i<_retired.size();++i)
+            delete _retired.begin()[i];
+    }
+
+private:
+
+    static constexpr size_t initial_capacity=256;
+
+    struct ring
+    {
+        size_t capacity;    //power of 2
+        std::atomic<pool_task*>* slots;
+
+        explicit ring(size_t n):capacity(n),slots(new std::atomic<pool_task*>[n]){}
+
+        ~ring() {delete[] slots;}
+
+        pool_task* get(long i) const {return slots[i&(capacity-1)].load(std::memory_order_relaxed);}
+
+        void put(long i,pool_task* task) {slots[i&(capacity-1)].store(task,std::memory_order_relaxed);}
+    };
+
+    std::atomic<long> _top;
+    std::atomic<long> _bottom;
+    std::atomic<ring*> _ring;
+    vector<ring*> _retired;     //owner only
+
+
+    ring* grow(ring* r,long t,long b)
+    {
+        ring* bigger=new ring(r->capacity*2);
+        for(long i=t;i<b;++i)
+            bigger->put(i,r->get(i));
+        _retired.push_back(r);
+        _ring.store(bigger);
+        return bigger;
+    }
+};
+
+
+//a forked task on the forking thread's stack,joined before the frame goes away
+template <class Function>
+struct pool_join_task : public pool_task
+{
+    Function* f;
+    std::atomic<bool> done;
+    std::exception_ptr error;
+
+    explicit pool_join_task(Function& func):f(&func),done(false)
+    {
+        execute=&run;
+    }
+
+    static void run(pool_task* task)
+    {
+        pool_join_task* self=static_cast<pool_join_task*>(task);
+        try{
+            (*self->f)();
+        }catch(...){
+            self->error=std::current_exception();
+        }
+        self->done.store(true,std::memory_order_release);
+    }
+};
+
+//a fork/join call made outside the pool,run as a whole by a worker.
+//the caller sleeps on done_cv until done.
+template <class Function>
+struct pool_root_task : public pool_task
+{
+    Function* f;
+    bool done;      //under done_mutex
+    std::exception_ptr error;
+    std::mutex* done_mutex;
+    std::condition_variable* done_cv;
+
+    pool_root_task(Function& func,std::mutex& m,std::condition_variable& cv)
+        :f(&func),done(false),done_mutex(&m),done_cv(&cv)
+    {
+        execute=&run;
+    }
+
+    static void run(pool_task* task)
+    {
+        pool_root_task* self=static_cast<pool_root_task*>(task);
+        try{
+            (*self->f)();
+        }catch(...){
+            self->error=std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(*self->done_mutex);
+        self->done=true;
+        self->done_cv->notify_all();
+    }
+};
+
+//a submitted task,owned by the pool
+template <class Function>
+struct pool_heap_task : public pool_task
+{
+    Function f;
+
+    explicit pool_heap_task(const Function& func):f(func)
+    {
+        execute=&run;
+    }
+
+    //nobody waits for it,so an exception has nowhere to go
+    static void run(pool_task* task)
+    {
+        pool_heap_task* self=static_cast<pool_heap_task*>(task);
+        try{
+            self->f();
+        }catch(...){
+            std::terminate();
+        }
+        delete self;
+    }
+};
+
+
+//work-stealing thread pool.
+//every worker has a work_stealing_deque:tasks forked on a worker go to the bottom
+//of its own deque and are taken back LIFO(cache-warm,depth-first);an idle worker
+//steals the oldest task(the biggest piece of work) from a random victim.threads
+//outside the pool hand tasks in through a locked injection queue.
+//a worker waiting for a join runs other tasks meanwhile,so nested fork/join never
+//blocks it.a fork/join call from outside the pool is handed to a worker whole,and
+//the caller sleeps until it is done:forking only ever happens on worker deques.
+//idle workers sleep on a condition variable.
+//
+//exceptions thrown by forked functions are rethrown by the forking call once all
+//its tasks are joined.a submitted task must not throw.
+//
+//usage:
+//  thread_pool& pool=thread_pool::instance();
+//  pool.parallel_invoke([&]{left();},[&]{right();});
+//  pool.parallel_for(0,n,[&](size_t i){a[i]=f(i);});
+//  pool.submit([=]{log(msg);});
+class thread_pool
+{
+public:
+
+    //worker threads(0:one per hardware thread)
+    explicit thread_pool(size_t threads=0):_injected_count(0),_sleeping(0),_pending(0),_signal(0),_stop(false)
+    {
+        if(threads==0)
+            threads=std::thread::hardware_concurrency();
+        if(threads==0)
+            threads=1;
+        for(size_t t=0;t<threads;++t)
+            _deques.push_back(new work_stealing_deque);
+        for(size_t t=0;t<_deques.size();++t)
+            _workers.push_back(new std::thread(&thread_pool::worker_loop,this,t));
+    }
+
+    thread_pool(const thread_pool&)=delete;
+
+    thread_pool& operator=(const thread_pool&)=delete;
+
+
+    //the pool the parallel algorithms use
+    static thread_pool& instance()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+
+    //worker threads
+    size_t size() const {return _workers.size();}
+
+
+    //run f() some time later on a worker,fire and forget.
+    //the pool's destructor waits for the submitted tasks.
+    template <class Function>
+    void submit(Function f)
+    {
+        _pending.fetch_add(1);
+        push(new pool_heap_task<pending_task<Function>>(pending_task<Function>{f,this}));
+    }
+
+
+    //fork/join:run all functions,possibly concurrently,return when all are done
+    template <class Function1,class Function2>
+    void parallel_invoke(Function1 f1,Function2 f2)
+    {
+        if(self()==size_t(-1)){
+            auto call=[&](){parallel_invoke(f1,f2);};
+            run_outside(call);
+            return;
+        }
+
+        pool_join_task<Function2> task(f2);
+        push(&task);
+        try{
+            f1();
+        }catch(...){
+            join(task,false);
+            throw;
+        }
+        join(task,true);
+    }
+
+    template <class Function1,class Function2,class Function3,class... Functions>
+    void parallel_invoke(Function1 f1,Function2 f2,Function3 f3,Functions... fs)
+    {
+        auto rest=[&](){parallel_invoke(f2,f3,fs...);};
+        parallel_invoke(f1,rest);
+    }
+
+
+    //f(i) for every i in [first,last).the range is halved recursively,one half
+    //forked,until pieces are at most grain long(0:about 8 pieces per thread).
+    //idle workers steal the big halves first,so the load balances itself.
+    template <class Index,class Function>
+    void parallel_for(Index first,Index last,Function f,size_t grain=0)
+    {
+        if(!(first<last)) return;
+        size_t n=last-first;
+        if(grain==0)
+            grain=n/(size()*8);
+        if(grain==0)
+            grain=1;
+        if(n>grain && self()==size_t(-1)){
+            auto call=[&](){parallel_for_range(first,last,f,grain);};
+            run_outside(call);
+            return;
+        }
+        parallel_for_range(first,last,f,grain);
+    }
+
+
+    //f(0)...f(tasks-1),one task each.used by execution.h for its chunks.
+    template <class Function>
+    void run(size_t tasks,Function f)
+    {
+        parallel_for(size_t(0),tasks,f,1);
+    }
+
+
+    //destructor:runs what was submitted,then stops the workers
+    ~thread_pool()
+    {
+        while(_pending.load()!=0)
+            std::this_thread::yield();
+        {
+            std::lock_guard<std::mutex> lock(_sleep_mutex);
+            _stop=true;
+            ++_signal;
+        }
+        _wake.notify_all();
+        for(size_t t=0;t<_workers.size();++t){
+            _workers.begin()[t]->join();
+            delete _workers.begin()[t];
+        }
+        for(size_t t=0;t<_deques.size();++t)   //thieves are gone only now
+            delete _deques.begin()[t];
+    }
+
+private:
+
+    //the calling thread's place:which pool it works for and its deque
+    struct worker_id
+    {
+        thread_pool* pool;
+        size_t index;
+        unsigned long seed;     //victim choice
+    };
+
+    template <class Function>
+    struct pending_task
+    {
+        Function f;
+        thread_pool* pool;
+
+        void operator()()
+        {
+            f();
+            pool->_pending.fetch_sub(1);
+        }
+    };
+
+    //the forked half of a parallel_for range
+    template <class Index,class Function>
+    struct for_half
+    {
+        thread_pool* pool;
+        Index first,last;
+        Function* f;
+        size_t grain;
+
+        void operator()() const {pool->parallel_for_range(first,last,*f,grain);}
+    };
+
+    //spins over an empty pool before a worker goes to sleep
+    static constexpr int idle_spins=64;
+
+    vector<std::thread*> _workers;
+    vector<work_stealing_deque*> _deques;
+    vector<pool_task*> _injected;           //tasks from outside threads
+    std::mutex _inject_mutex;
+    std::atomic<size_t> _injected_count;
+    std::atomic<unsigned> _sleeping;
+    std::atomic<size_t> _pending;           //submitted tasks not finished
+    std::mutex _sleep_mutex;
+    std::condition_variable _wake;
+    std::mutex _done_mutex;                 //outside callers wait on _done
+    std::condition_variable _done;
+    unsigned long _signal;                  //bumped under _sleep_mutex to wake sleepers
+    bool _stop;
+
+
+    static worker_id& this_worker()
+    {
+        static thread_local worker_id id={nullptr,0,0};
+        return id;
+    }
+
+    //index of the calling thread's deque,size_t(-1) if it is not our worker
+    size_t self() const
+    {
+        const worker_id& id=this_worker();
+        return id.pool==this ? id.index : size_t(-1);
+    }
+
+
+    template <class Index,class Function>
+    void parallel_for_range(Index first,Index last,Function& f,size_t grain)
+    {
+        if(static_cast<size_t>(last-first)<=grain){
+            for(;first!=last;++first)
+                f(first);
+            return;
+        }
+
+        Index middle=first+(last-first)/2;
+        for_half<Index,Function> right{this,middle,last,&f,grain};
+        pool_join_task<for_half<Index,Function>> task(right);
+        push(&task);
+        try{
+            parallel_for_range(first,middle,f,grain);
+        }catch(...){
+            join(task,false);
+            throw;
+        }
+        join(task,true);
+    }
+
+
+    //hand a fork/join call to the workers and sleep until it is done
+    template <class Function>
+    void run_outside(Function& f)
+    {
+        pool_root_task<Function> task(f,_done_mutex,_done);
+        push(&task);
+        {
+            std::unique_lock<std::mutex> lock(_done_mutex);
+            _done.wait(lock,[&]{return task.done;});
+        }
+        if(task.error)
+            std::rethrow_exception(task.error);
+    }
+
+    //queue a task:own deque on a worker,the injection queue elsewhere
+    void push(pool_task* task)
+    {
+        size_t i=self();
+        if(i!=size_t(-1)){
+            _deques.begin()[i]->push(task);
+        }else{
+            std::lock_guard<std::mutex> lock(_inject_mutex);
+            _injected.push_back(task);
+            _injected_count.fetch_add(1);
+        }
+        if(_sleeping.load()!=0){
+            {
+                std::lock_guard<std::mutex> lock(_sleep_mutex);
+                ++_signal;
+            }
+            _wake.notify_one();
+        }
+    }
+
+    pool_task* take_injected()
+    {
+        if(_injected_count.load()==0) return nullptr;
+        std::lock_guard<std::mutex> lock(_inject_mutex);
+        if(_injected.empty()) return nullptr;
+        pool_task* task=_injected.begin()[0];
+        _injected.erase(_injected.begin());
+        _injected_count.fetch_sub(1);
+        return task;
+    }
+
+    //own deque first,then the injection queue,then one round of stealing
+    pool_task* find_task()
+    {
+        size_t i=self();
+        pool_task* task;
+        if(i!=size_t(-1) && (task=_deques.begin()[i]->take()))
+            return task;
+        if((task=take_injected()))
+            return task;
+
+        size_t n=_deques.size();
+        if(n==0) return nullptr;
+        worker_id& id=this_worker();
+        id.seed=id.seed*6364136223846793005ul+1442695040888963407ul;
+        size_t start=(id.seed >> 33)%n;
+        for(size_t k=0;k<n;++k){
+            size_t victim=(start+k)%n;
+            if(victim!=i && (task=_deques.begin()[victim]->steal()))
+                return task;
+        }
+        return nullptr;
+    }
+
+    bool help()
+    {
+        pool_task* task=find_task();
+        if(!task) return false;
+        task->execute(task);
+        return true;
+    }
+
+    //wait for a forked task,running others meanwhile.
+    //usually the task is still on top of our own deque and we take it back.
+    template <class Function>
+    void join(pool_join_task<Function>& task,bool rethrow)
+    {
+        while(!task.done.load(std::memory_order_acquire))
+            if(!help())
+                std::this_thread::yield();
+        if(rethrow && task.error)
+            std::rethrow_exception(task.error);
+    }
+
+    bool has_work() const
+    {
+        if(_injected_count.load()!=0) return true;
+        for(size_t i=0;i<_deques.size();++i)
+            if(!_deques.begin()[i]->empty())
+                return true;
+        return false;
+    }
+
+    void worker_loop(size_t index)
+    {
+        worker_id& id=this_worker();
+        id.pool=this;
+        id.index=index;
+        id.seed=index+1;
+
+        for(int idle=0;;){
+            if(help()){
+                idle=0;
+                continue;
+            }
+            if(++idle<idle_spins){
+                std::this_thread::yield();
+                continue;
+            }
+
+            //a push either sees _sleeping raised or is seen by has_work
+            std::unique_lock<std::mutex> lock(_sleep_mutex);
+            if(_stop) return;
+            _sleeping.fetch_add(1);
+            unsigned long seen=_signal;
+            if(!has_work())
+                _wake.wait(lock,[&]{return _signal!=seen || _stop;});
+            _sleeping.fetch_sub(1);
+            idle=0;
+        }
+    }
+
+};
+
+
+//the shared pool
+template <class Function1,class Function2,class... Functions>
+void parallel_invoke(Function1 f1,Function2 f2,Functions... fs)
+{
+    thread_pool::instance().parallel_invoke(f1,f2,fs...);
+}
+
+template <class Index,class Function>
+void parallel_for(Index first,Index last,Function f,size_t grain=0)
+{
+    thread_pool::instance().parallel_for(first,last,f,grain);
+}
+
+
+SSTL_NAMESPACE_END
+
+
+#endif // THREAD_POOL_H_INCLUDED
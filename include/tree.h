@@ -5,6 +5,7 @@
 #include "allocator.h"
 #include "iterator.h"
 #include "function.h"
+#include "type_traits.h"
 #include "utilities.h"
 #include "algorithm.h"
 
@@ -18,34 +19,91 @@ constexpr rb_tree_color_type rb_tree_black=true;
 constexpr rb_tree_color_type rb_tree_red=false;
 
 
-//inorder
+//node update policies
+//an update policy is called on a node whenever its subtree changes(children
+//reattached by a rotation,a node attached below or removed from below it).
+//children are always updated before their parents.
+//
+//a user policy provides:
+//  metadata_type                   aggregate stored in every node(trivially copyable)
+//  void operator()(PNode p) const  recompute p->metadata from p->value and
+//                                  p->left->metadata,p->right->metadata(children may be null)
+//if a value is modified in place,call rb_tree::update_metadata(iter) afterwards.
+
+//no augmentation
+struct rb_tree_no_metadata{};
+
+struct rb_tree_null_update
+{
+    typedef rb_tree_no_metadata metadata_type;
+
+    template <class PNode>
+    void operator()(PNode) const {}
+};
+
+//subtree size,for nth/rank/distance in O(log n)
+struct rb_tree_order_statistics_update
+{
+    typedef size_t metadata_type;
+
+    template <class PNode>
+    void operator()(PNode p) const
+    {
+        p->metadata=1+(p->left ? p->left->metadata : 0)+(p->right ? p->right->metadata : 0);
+    }
+};
+
+
+//traversals walk the parent links,so they need no stack and no recursion.
+//func must not relink the nodes.
+
+//inorder(visits a node,then its left and right subtrees)
 template <class PNode,class Function>
 void dfs_search_inorder(PNode root,Function func)
 {
     if(!root) return;
-    func(root);
-    if(root->left)
-        dfs_search_inorder(root->left,func);
-    if(root->right)
-        dfs_search_inorder(root->right,func);
-
+    PNode p=root;
+    for(;;){
+        func(p);
+        if(p->left)
+            p=p->left;
+        else if(p->right)
+            p=p->right;
+        else{
+            //climb to the nearest ancestor with a right subtree still to visit
+            while(p!=root && (p->parent->right==p || !p->parent->right))
+                p=p->parent;
+            if(p==root) return;
+            p=p->parent->right;
+        }
+    }
 }
 
-//preorder
+//preorder(visits the left subtree,the node,then the right subtree)
 template <class PNode,class Function>
 void dfs_search_preorder(PNode root,Function func)
 {
     if(!root) return;
-    if(root->left)
-        dfs_search_preorder(root->left,func);
-    func(root);
-    if(root->right)
-        dfs_search_preorder(root->right,func);
-
+    PNode p=root;
+    while(p->left)
+        p=p->left;
+    for(;;){
+        func(p);
+        if(p->right){
+            p=p->right;
+            while(p->left)
+                p=p->left;
+        }else{
+            while(p!=root && p->parent->right==p)
+                p=p->parent;
+            if(p==root) return;
+            p=p->parent;
+        }
+    }
 }
 
-template <class PNode>
-PNode tree_rotate_left(PNode x)
+template <class PNode,class NodeUpdate=rb_tree_null_update>
+PNode tree_rotate_left(PNode x,NodeUpdate update=NodeUpdate())
 {
     PNode y=x->right;
     x->right=y->left;
@@ -62,11 +120,14 @@ PNode tree_rotate_left(PNode x)
 
     y->left=x;
     x->parent=y;
+
+    update(x);      //x is y's child now.
+    update(y);
     return y;
 }
 
-template <class PNode>
-PNode tree_rotate_right(PNode x)
+template <class PNode,class NodeUpdate=rb_tree_null_update>
+PNode tree_rotate_right(PNode x,NodeUpdate update=NodeUpdate())
 {
     PNode y=x->left;
     x->left=y->right;
@@ -83,24 +144,43 @@ PNode tree_rotate_right(PNode x)
 
     y->right=x;
     x->parent=y;
+
+    update(x);
+    update(y);
     return y;
 }
 
 
-template <class T>
+template <class T,class Metadata=rb_tree_no_metadata>
 struct rb_tree_node
 {
     typedef rb_tree_color_type color_type;
+    typedef Metadata metadata_type;
 
     rb_tree_node* left;
     rb_tree_node* right;
     rb_tree_node* parent;
     color_type color;
     T value;
+    metadata_type metadata;     //maintained by the tree's node update policy
 };
 
-
+//plain node(no metadata)
 template <class T>
+struct rb_tree_node<T,rb_tree_no_metadata>
+{
+    typedef rb_tree_color_type color_type;
+    typedef rb_tree_no_metadata metadata_type;
+
+    rb_tree_node* left;
+    rb_tree_node* right;
+    rb_tree_node* parent;
+    color_type color;
+    T value;
+};
+
+
+template <class T,class Metadata=rb_tree_no_metadata>
 struct rb_tree_iterator
 {
     //typedefs
@@ -112,7 +192,7 @@ struct rb_tree_iterator
     typedef ptrdiff_t                   difference_type;
 
     typedef rb_tree_iterator            iterator;
-    typedef rb_tree_node<T>*            link_type;
+    typedef rb_tree_node<T,Metadata>*   link_type;
 
 
     //wrapped pointer
@@ -188,7 +268,13 @@ struct rb_tree_iterator
 };
 
 
-template <class Key,class Value,class KeyOfValue,class Compare=less<Key>,class Alloc=malloc_alloc>
+//parallel traversal of a tree,defined in parallel_tree.h
+template <class Tree>
+struct rb_tree_parallel;
+
+
+template <class Key,class Value,class KeyOfValue,class Compare=less<Key>,class Alloc=malloc_alloc,
+          class NodeUpdate=rb_tree_null_update>
 class rb_tree
 {
 public:
@@ -196,8 +282,11 @@ public:
     typedef Key         key_type;
     typedef Value       value_type;
     typedef Compare     key_compare;
+    typedef NodeUpdate  node_update;
 
-    typedef rb_tree_iterator<value_type>        iterator;
+    typedef typename node_update::metadata_type metadata_type;
+
+    typedef rb_tree_iterator<value_type,metadata_type>  iterator;
     typedef reverse_iterator<iterator>          reverse_iterator;
     typedef const_iterator<reverse_iterator>    const_reverse_iterator;
     typedef const_iterator<iterator>            const_iterator;
@@ -208,17 +297,17 @@ public:
     typedef const value_type&                   const_reference;
     typedef ptrdiff_t                           difference_type;
 
-    typedef rb_tree_node<value_type>            rb_tree_node;
+    typedef rb_tree_node<value_type,metadata_type>  rb_tree_node;
     typedef rb_tree_node*                       link_type;
 
 
     //constructors
     rb_tree(const key_compare& comp=key_compare()):_size(0),_comp(comp){empty_initialize();}
 
-    rb_tree(const rb_tree& t):_comp(t._comp)
+    rb_tree(const rb_tree& t):_size(0),_comp(t._comp),_update(t._update)
     {
         empty_initialize();
-        insert_equal(t.cbegin(),t.cend());
+        copy_from(t);
     }
 
 
@@ -226,9 +315,11 @@ public:
     //assignment
     rb_tree& operator=(const rb_tree& t)
     {
-        _comp=t._comp;
+        if(this==&t) return *this;
         clear();
-        insert_equal(t.cbegin(),t.cend());
+        _comp=t._comp;
+        _update=t._update;
+        copy_from(t);
         return *this;
     }
 
@@ -239,6 +330,7 @@ public:
         link_type tmp_header=_header;_header=t._header;t._header=tmp_header;
         size_type tmp_size=_size;_size=t._size;t._size=tmp_size;
         key_compare tmp_comp=_comp;_comp=t._comp;t._comp=tmp_comp;
+        node_update tmp_update=_update;_update=t._update;t._update=tmp_update;
     }
 
     key_compare key_comp() const {return _comp;}
@@ -270,26 +362,61 @@ public:
 
 
     //insert
-    pair<iterator,bool> insert_unique(const_reference value){
-        iterator ret=find(KeyOfValue()(value));
-        if(ret!=end()) return {ret,false};
+    pair<iterator,bool> insert_unique(const_reference value)
+    {
+        pair<link_type,bool> pos;
+        link_type same=insert_unique_find(KeyOfValue()(value),pos);
+        if(same) return {same,false};
 
         link_type p=create_node(value);
-        insert_node(p,insert_find(value));
-        insert_rebalance(p);
-        ++_size;
+        link_new_node(p,pos);
         return {p,true};
     }
 
     iterator insert_equal(const_reference value)
     {
         link_type p=create_node(value);
-        insert_node(p,insert_find(value));
-        insert_rebalance(p);
-        ++_size;
+        link_new_node(p,insert_find(value));
+        return p;
+    }
+
+    //construct the value from args in the node,drop it if the key is taken
+    template <class... Args>
+    pair<iterator,bool> emplace_unique(Args&&... args)
+    {
+        link_type p=create_node_from(std::forward<Args>(args)...);
+        pair<link_type,bool> pos;
+        link_type same=insert_unique_find(get_key(p),pos);
+        if(same){
+            destroy_node(p);
+            return {same,false};
+        }
+        link_new_node(p,pos);
+        return {p,true};
+    }
+
+    template <class... Args>
+    iterator emplace_equal(Args&&... args)
+    {
+        link_type p=create_node_from(std::forward<Args>(args)...);
+        link_new_node(p,insert_find(p->value));
         return p;
     }
 
+    //k is the key the value built from args will have:
+    //nothing is constructed if it is already present.
+    template <class... Args>
+    pair<iterator,bool> emplace_unique_key(const key_type& k,Args&&... args)
+    {
+        pair<link_type,bool> pos;
+        link_type same=insert_unique_find(k,pos);
+        if(same) return {same,false};
+
+        link_type p=create_node_from(std::forward<Args>(args)...);
+        link_new_node(p,pos);
+        return {p,true};
+    }
+
     template <class InputIterator>
     void insert_unique(InputIterator begin,InputIterator end)
     {
@@ -357,82 +484,105 @@ public:
 
 
     //unique(key)
-    iterator find(const key_type& k) const
+    iterator find(const key_type& k) const {return find_key(k);}
+
+    size_type count(const key_type& k) const {return count_key(k);}
+
+    iterator lower_bound(const key_type& k) const {return lower_bound_node(k);}
+
+    iterator upper_bound(const key_type& k) const {return upper_bound_node(k);}
+
+    pair<iterator,iterator> equal_range(const key_type& k) const
     {
-        link_type prev=_header;
-        link_type cur=_header->parent;
+        return {lower_bound_node(k),upper_bound_node(k)};
+    }
+
+
+    //heterogeneous lookup,only with a transparent key_compare(less<>)
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator find(const K& k) const {return find_key(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    size_type count(const K& k) const {return count_key(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator lower_bound(const K& k) const {return lower_bound_node(k);}
 
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    iterator upper_bound(const K& k) const {return upper_bound_node(k);}
+
+    template <class K,class C=key_compare,class=typename enable_if<is_transparent<C>::value>::type>
+    pair<iterator,iterator> equal_range(const K& k) const
+    {
+        return {lower_bound_node(k),upper_bound_node(k)};
+    }
+
+
+    //order statistics(NodeUpdate must be rb_tree_order_statistics_update,checked at compile time)
+    //k-th element(from 0),end() if k>=size().
+    iterator nth(size_type k) const
+    {
+        static_assert(std::is_same<NodeUpdate,rb_tree_order_statistics_update>::value,
+                      "nth needs NodeUpdate=rb_tree_order_statistics_update");
+        link_type cur=_header->parent;
         while(cur){
-            if(!_comp(get_key(cur),k)){
-                prev=cur;
+            size_type left_size=subtree_size(cur->left);
+            if(k<left_size){
                 cur=cur->left;
+            }else if(k==left_size){
+                return cur;
             }else{
+                k-=left_size+1;
                 cur=cur->right;
             }
         }
-        iterator iter(prev);
-        return (iter==end() || _comp(k,get_key(prev))) ? end() : iter;
-    }
-
-    size_type count(const key_type& k) const
-    {
-        iterator iter=find(k);
-        if(iter==end()) return 0;
-        size_type cnt=1;
-        reverse_iterator left=reverse_iterator(iter);
-        while(left!=rend() && !_comp(KeyOfValue()(*left++),k))
-            ++cnt;
-        iterator right=++iter;
-        while(right!=end() && !_comp(k,KeyOfValue()(*right++)))
-            ++cnt;
-
-        return cnt;
+        return end();
     }
 
-    iterator lower_bound(const key_type& k) const
+    //number of elements less than k,that is the position of lower_bound(k).
+    size_type rank(const key_type& k) const
     {
-        difference_type len=_size;
-        difference_type half;
-        iterator middle,left=begin();
-        while(len>0){
-            half=len >> 1;
-            middle=sstl::advance(left,half);
-            if(_comp(KeyOfValue()(*middle),k)){
-                left=middle;
-                ++left;
-                len=len-half-1;
+        static_assert(std::is_same<NodeUpdate,rb_tree_order_statistics_update>::value,
+                      "rank needs NodeUpdate=rb_tree_order_statistics_update");
+        size_type r=0;
+        link_type cur=_header->parent;
+        while(cur){
+            if(_comp(get_key(cur),k)){
+                r+=subtree_size(cur->left)+1;
+                cur=cur->right;
             }else{
-                len=half;
+                cur=cur->left;
             }
         }
-        return left;
+        return r;
     }
 
-    iterator upper_bound(const key_type& k) const
+    //position of iter,size() for end().
+    size_type order_of(iterator iter) const
     {
-        difference_type len=_size;
-        difference_type half;
-        iterator middle,left=begin();
-        while(len>0){
-            half=len >> 1;
-            middle=sstl::advance(left,half);
-            if(_comp(k,KeyOfValue()(*middle))){
-                len=half;
-            }else{
-                left=middle;
-                ++left;
-                len=len-half-1;
-            }
-        }
-        return left;
+        static_assert(std::is_same<NodeUpdate,rb_tree_order_statistics_update>::value,
+                      "order_of/distance needs NodeUpdate=rb_tree_order_statistics_update");
+        link_type x=iter._node;
+        if(x==_header) return _size;
+
+        size_type r=subtree_size(x->left);
+        for(;x!=_header->parent;x=x->parent)
+            if(x==x->parent->right)
+                r+=subtree_size(x->parent->left)+1;
+        return r;
     }
 
-    pair<iterator,iterator> equal_range(const key_type& k) const
+    difference_type distance(iterator begin,iterator end) const
     {
-        return {lower_bound(k),upper_bound(k)};
+        return difference_type(order_of(end))-difference_type(order_of(begin));
     }
 
 
+    //node update
+    //recompute the metadata from iter up to the root,after *iter was modified in place.
+    void update_metadata(iterator iter) {update_to_root(iter._node);}
+
+
     //extra
     link_type root() const {return _header->parent;}
 
@@ -446,6 +596,7 @@ private:
     link_type _header;
     size_type _size;
     key_compare _comp;
+    node_update _update;
 
 
     //min and max
@@ -461,6 +612,74 @@ private:
     }
 
 
+    //lookup descents,K is key_type or a key-like type of a transparent comparator
+    template <class K>
+    link_type lower_bound_node(const K& k) const
+    {
+        link_type prev=_header;
+        link_type cur=_header->parent;
+        while(cur){
+            if(!_comp(get_key(cur),k)){
+                prev=cur;
+                cur=cur->left;
+            }else{
+                cur=cur->right;
+            }
+        }
+        return prev;
+    }
+
+    template <class K>
+    link_type upper_bound_node(const K& k) const
+    {
+        link_type prev=_header;
+        link_type cur=_header->parent;
+        while(cur){
+            if(_comp(k,get_key(cur))){
+                prev=cur;
+                cur=cur->left;
+            }else{
+                cur=cur->right;
+            }
+        }
+        return prev;
+    }
+
+    template <class K>
+    iterator find_key(const K& k) const
+    {
+        link_type p=lower_bound_node(k);
+        return (p==_header || _comp(k,get_key(p))) ? end() : iterator(p);
+    }
+
+    template <class K>
+    size_type count_key(const K& k) const
+    {
+        iterator first=find_key(k);
+        if(first==end()) return 0;
+        iterator last=upper_bound_node(k);
+        size_type cnt=0;
+        for(;first!=last;++first)
+            ++cnt;
+        return cnt;
+    }
+
+
+    //subtree size(order statistics)
+    static size_type subtree_size(link_type p)
+    {
+        return p ? p->metadata : 0;
+    }
+
+
+    //recompute the metadata of p and all its ancestors
+    void update_to_root(link_type p)
+    {
+        for(;p!=_header;p=p->parent)
+            _update(p);
+    }
+
+
     //allocate and deallocate
     link_type get_node(){return tree_node_allocator::allocate();}
 
@@ -475,6 +694,19 @@ private:
         p->color=rb_tree_red;
         p->left=nullptr;
         p->right=nullptr;
+        _update(p);
+        return p;
+    }
+
+    template <class... Args>
+    link_type create_node_from(Args&&... args)
+    {
+        link_type p=get_node();
+        new(&p->value) value_type(std::forward<Args>(args)...);
+        p->color=rb_tree_red;
+        p->left=nullptr;
+        p->right=nullptr;
+        _update(p);
         return p;
     }
 
@@ -496,15 +728,94 @@ private:
     }
 
 
-    //postorder-destroy(for clear())
+    //postorder-destroy(for clear()),detaching each leaf from its parent
     void dfs_destroy(link_type root)
     {
-        if(!root) return;
-        if(root->left)
-            dfs_destroy(root->left);
-        if(root->right)
-            dfs_destroy(root->right);
-        destroy_node(root);
+        link_type p=root;
+        while(p){
+            if(p->left)
+                p=p->left;
+            else if(p->right)
+                p=p->right;
+            else{
+                link_type parent=p->parent;
+                if(p==root)
+                    parent=nullptr;
+                else if(parent->left==p)
+                    parent->left=nullptr;
+                else
+                    parent->right=nullptr;
+                destroy_node(p);
+                p=parent;
+            }
+        }
+    }
+
+
+    //structural copy
+    link_type clone_node(link_type src)
+    {
+        link_type p=get_node();
+        construct(&p->value,src->value);
+        p->color=src->color;
+        p->left=nullptr;
+        p->right=nullptr;
+        clone_metadata(p,src,static_cast<metadata_type*>(nullptr));
+        return p;
+    }
+
+    void clone_metadata(link_type,link_type,rb_tree_no_metadata*) {}
+
+    template <class Metadata>
+    void clone_metadata(link_type p,link_type src,Metadata*) {p->metadata=src->metadata;}
+
+    //copy the subtree at src below parent,same shape and colors,in preorder.
+    link_type copy_tree(link_type src,link_type parent)
+    {
+        link_type top=clone_node(src);
+        top->parent=parent;
+        link_type s=src,d=top;
+        for(;;){
+            if(s->left){
+                s=s->left;
+                d->left=clone_node(s);
+                d->left->parent=d;
+                d=d->left;
+            }else if(s->right){
+                s=s->right;
+                d->right=clone_node(s);
+                d->right->parent=d;
+                d=d->right;
+            }else{
+                while(s!=src && (s->parent->right==s || !s->parent->right)){
+                    s=s->parent;
+                    d=d->parent;
+                }
+                if(s==src) return top;
+                s=s->parent->right;
+                d=d->parent;
+                d->right=clone_node(s);
+                d->right->parent=d;
+                d=d->right;
+            }
+        }
+    }
+
+    //*this is empty
+    void copy_from(const rb_tree& t)
+    {
+        if(!t.root()) return;
+        link_type root=copy_tree(t.root(),_header);
+        _header->parent=root;
+        link_type p=root;
+        while(p->left)
+            p=p->left;
+        _header->left=p;
+        p=root;
+        while(p->right)
+            p=p->right;
+        _header->right=p;
+        _size=t._size;
     }
 
 
@@ -521,7 +832,13 @@ private:
 
 
     //insert aux
+    //(parent,as left child) for a new node with the key of value
     pair<link_type,bool> insert_find(const_reference value)
+    {
+        return insert_find_key(KeyOfValue()(value));
+    }
+
+    pair<link_type,bool> insert_find_key(const key_type& k)
     {
         bool direc=true;
         link_type prev=_header;
@@ -529,13 +846,35 @@ private:
 
         while(cur){
             prev=cur;
-            direc=_comp(KeyOfValue()(value),get_key(cur));
+            direc=_comp(k,get_key(cur));
             cur= direc ? cur->left : cur->right;
 
         }
         return {prev,direc};
     }
 
+    //the node with key k,or nullptr and pos set to where k goes(one descent)
+    link_type insert_unique_find(const key_type& k,pair<link_type,bool>& pos)
+    {
+        pos=insert_find_key(k);
+        link_type j=pos.first;
+        if(pos.second){
+            if(j==_header || j==_header->left) return nullptr;
+            iterator prev(j);
+            --prev;
+            j=prev._node;
+        }
+        return _comp(get_key(j),k) ? nullptr : j;
+    }
+
+    void link_new_node(link_type p,pair<link_type,bool> pos)
+    {
+        insert_node(p,pos);
+        update_to_root(p->parent);
+        insert_rebalance(p);
+        ++_size;
+    }
+
 
     //insert and erase node
     void insert_node(link_type tar,pair<link_type,bool> pos)
@@ -582,6 +921,8 @@ private:
                 child->parent->left=child;
             else
                 child->parent->right=child;
+
+            update_to_root(child->parent);
         }else{
             link_type x=tar->parent;
 
@@ -596,6 +937,8 @@ private:
                 x->left=nullptr;
             else
                 x->right=nullptr;
+
+            update_to_root(x);
         }
         destroy_node(tar);
     }
@@ -616,12 +959,12 @@ private:
                 tar_grandparent->color=rb_tree_red;
             }else{
                 if(tar_parent->right==tar){
-                    tar_parent=tree_rotate_left(tar_parent);
+                    tar_parent=tree_rotate_left(tar_parent,_update);
                     tar=tar_parent->left;
                 }
                 tar_parent->color=rb_tree_black;
                 tar_grandparent->color=rb_tree_red;
-                top=tree_rotate_right(tar_grandparent);
+                top=tree_rotate_right(tar_grandparent,_update);
             }
 
         }else{
@@ -631,12 +974,12 @@ private:
                 tar_grandparent->color=rb_tree_red;
             }else{
                 if(tar->parent->left==tar){
-                    tar_parent=tree_rotate_right(tar_parent);
+                    tar_parent=tree_rotate_right(tar_parent,_update);
                     tar=tar_parent->right;
                 }
                 tar_parent->color=rb_tree_black;
                 tar_grandparent->color=rb_tree_red;
-                top=tree_rotate_left(tar_grandparent);
+                top=tree_rotate_left(tar_grandparent,_update);
             }
         }
         //guarantee root's color is black
@@ -653,45 +996,40 @@ private:
         if(tar->left || tar->right){                                    //black node with a child node
             link_type child= (tar->left!=nullptr ? tar->left : tar->right);
             child->color=rb_tree_black;                             //case 2 end
-        }else{                                                      //black leaf node
-            link_type p=tar->parent;
+            return;
+        }
+                                                                    //black leaf node
+        link_type x=tar;                                            //x carries an extra black.
+        while(x!=_header->parent && is_black(x)){
+            link_type p=x->parent;
             link_type b;
 
-            if(tar==p->left){
+            if(x==p->left){
                 b=p->right;
-                                            //tar is left node.
+                                            //x is left node.
                 if(is_red(b)){
                     p->color=rb_tree_red;
                     b->color=rb_tree_black;
-                    tree_rotate_left(p);
+                    tree_rotate_left(p,_update);
                     b=p->right;
                 }                                   //--->  b->color==black.
 
-                link_type bl=b->left;
-                link_type br=b->right;
-
-                if(is_red(bl) && is_black(br)){
+                if(is_black(b->left) && is_black(b->right)){
                     b->color=rb_tree_red;
-                    bl->color=rb_tree_black;
-                    tree_rotate_right(b);
-                    br=b;
-                    b=bl;
-                }                                   //--->  b->color=black && br->color==red(if br exists).
-
-                if(is_red(br)){
-                    rb_tree_color_type tmp=p->color;        //swap p->color and b->color.
-                    p->color=b->color;
-                    b->color=tmp;
-                    br->color=rb_tree_black;
-                    tree_rotate_left(p);                    //case 3 end.
-                }else{                                      //b is a leaf node.
-                    if(is_red(p)){                          //p->color is red.
-                        p->color=rb_tree_black;
-                        b->color=rb_tree_red;               //case 4 end.
-                    }else{
+                    x=p;                                    //case 4 end if p is red,case 5 loop otherwise.
+                }else{
+                    if(is_black(b->right)){
+                        b->left->color=rb_tree_black;
                         b->color=rb_tree_red;
-                        erase_rebalance(p);                 //case 5 loop.
-                    }
+                        tree_rotate_right(b,_update);
+                        b=p->right;
+                    }                               //--->  b->right->color==red.
+
+                    b->color=p->color;
+                    p->color=rb_tree_black;
+                    b->right->color=rb_tree_black;
+                    tree_rotate_left(p,_update);            //case 3 end.
+                    x=_header->parent;
                 }
 
             }else{
@@ -700,39 +1038,31 @@ private:
                 if(is_red(b)){
                     p->color=rb_tree_red;
                     b->color=rb_tree_black;
-                    tree_rotate_right(p);
+                    tree_rotate_right(p,_update);
                     b=p->left;
                 }
 
-                link_type bl=b->left;
-                link_type br=b->right;
-
-                if(is_red(br) && is_black(bl)){
+                if(is_black(b->left) && is_black(b->right)){
                     b->color=rb_tree_red;
-                    br->color=rb_tree_black;
-                    tree_rotate_left(b);
-                    bl=b;
-                    b=br;
-                }
-
-                if(is_red(bl)){
-                    rb_tree_color_type tmp=p->color;        //swap p->color and b->color.
-                    p->color=b->color;
-                    b->color=tmp;
-                    bl->color=rb_tree_black;
-                    tree_rotate_right(p);
+                    x=p;
                 }else{
-                    if(is_red(p)){                          //p->color is red.
-                        p->color=rb_tree_black;
-                        b->color=rb_tree_red;               //case 4 end.
-                    }else{
+                    if(is_black(b->left)){
+                        b->right->color=rb_tree_black;
                         b->color=rb_tree_red;
-                        erase_rebalance(p);                 //case 5 loop.
+                        tree_rotate_left(b,_update);
+                        b=p->left;
                     }
+
+                    b->color=p->color;
+                    p->color=rb_tree_black;
+                    b->left->color=rb_tree_black;
+                    tree_rotate_right(p,_update);
+                    x=_header->parent;
                 }
 
             }
         }
+        x->color=rb_tree_black;
 
     }
 
@@ -3,6 +3,8 @@
 
 #include "sstl.h"
 
+#include <type_traits>
+
 
 SSTL_NAMESPACE_BEGIN
 
@@ -93,6 +95,54 @@ struct type_traits<unsigned long long>
 
 
 
+//bool_tag:true_type or false_type for a constant,to dispatch on a trait
+template <bool B>
+struct bool_tag
+{
+    typedef false_type type;
+};
+
+template <>
+struct bool_tag<true>
+{
+    typedef true_type type;
+};
+
+
+//is_trivially_copyable:a T can be copied with memmove
+template <class T>
+struct is_trivially_copyable
+{
+    static constexpr bool value=std::is_trivially_copyable<T>::value;
+};
+
+
+//enable_if
+template <bool Cond,class T=void>
+struct enable_if{};
+
+template <class T>
+struct enable_if<true,T>
+{
+    typedef T type;
+};
+
+
+//is_transparent:a comparator that declares is_transparent accepts any key-like type
+template <class Compare>
+struct is_transparent
+{
+private:
+    template <class U>
+    static char test(typename U::is_transparent*);
+
+    template <class U>
+    static long test(...);
+
+public:
+    static constexpr bool value=sizeof(test<Compare>(nullptr))==1;
+};
+
 
 SSTL_NAMESPACE_END
 
@@ -5,9 +5,16 @@
 #include "sstl.h"
 
 #include <initializer_list>
+#include <utility>  //std::forward
 
 SSTL_NAMESPACE_BEGIN
 
+//tag:build a pair's second member in place from the remaining arguments
+struct in_place_second_t{};
+
+constexpr in_place_second_t in_place_second{};
+
+
 template <class T1,class T2>
 struct pair
 {
@@ -24,6 +31,12 @@ struct pair
 
     pair(const pair& p):first(p.first),second(p.second){}
 
+    template <class U1,class U2>
+    pair(U1&& a,U2&& b):first(std::forward<U1>(a)),second(std::forward<U2>(b)){}
+
+    template <class U1,class... Args>
+    pair(in_place_second_t,U1&& a,Args&&... args):first(std::forward<U1>(a)),second(std::forward<Args>(args)...){}
+
     //relational operators
     bool operator==(const pair& p){return first==p.first && second==p.second;}
 
@@ -125,6 +125,19 @@ public:
     //insert
     void push_back(const_reference value){insert_fill(end(),value);}
 
+    //moves value in;it is moved aside first if the storage grows,in case it lives here
+    void push_back(value_type&& value)
+    {
+        if(_end==_cap){
+            value_type tmp(std::move(value));
+            chk_realloc();
+            construct(_end,std::move(tmp));
+        }else{
+            construct(_end,std::move(value));
+        }
+        ++_end;
+    }
+
     iterator insert(iterator tar,const_reference value){return insert_fill(tar,value);}
 
     template <typename... Args>
@@ -165,7 +178,7 @@ public:
         }else{
             chk_realloc(n);
             size_type extra=n-size();
-            uninitialized_fill_n(_end,extra);
+            sstl::uninitialized_fill_n(_end,extra);
             _end+=extra;
         }
     }
@@ -179,7 +192,7 @@ public:
         }else{
             chk_realloc(n);
             size_type extra=n-size();
-            uninitialized_fill_n(_end,extra,value);
+            sstl::uninitialized_fill_n(_end,extra,value);
             _end+=extra;
         }
     }
@@ -211,7 +224,7 @@ private:
         _begin=data_allocator::allocate(n);
         _cap=_end=_begin+n;
 
-        uninitialized_fill(_begin,_end);
+        sstl::uninitialized_fill(_begin,_end);
     }
 
     //memory related
@@ -225,7 +238,7 @@ private:
     void realloc(size_type cap)
     {
         auto tmp_begin=data_allocator::allocate(cap);
-        auto tmp_end=uninitialized_copy(_begin,_end,tmp_begin);
+        auto tmp_end=sstl::uninitialized_shear(_begin,_end,tmp_begin);
         free();
         _begin=tmp_begin;_end=tmp_end;_cap=_begin+cap;
     }
@@ -265,7 +278,7 @@ private:
         iterator ret=_end++;
         while(copy_size--){
             --ret;
-            construct(ret+1,*ret);
+            construct(ret+1,std::move(*ret));
             destroy(ret);
         }
         construct(ret,args...);
@@ -280,11 +293,11 @@ private:
         iterator ret=_end;
         while(copy_size--){
             --ret;
-            construct(ret+n,*ret);
+            construct(ret+n,std::move(*ret));
             destroy(ret);
         }
         _end+=n;
-        uninitialized_fill_n(ret,n,value);
+        sstl::uninitialized_fill_n(ret,n,value);
         return ret;
     }
 
@@ -298,11 +311,11 @@ private:
         iterator ret=_end;
         while(copy_size--){
             --ret;
-            construct(ret+n,*ret);
+            construct(ret+n,std::move(*ret));
             destroy(ret);
         }
         _end+=n;
-        uninitialized_copy(begin,end,ret);
+        sstl::uninitialized_copy(begin,end,ret);
         return ret;
     }
 
@@ -312,7 +325,7 @@ private:
     {
         destroy(tar,n);
         for(iterator iter=tar+n;iter!=_end;++iter){
-            construct(iter-n,*iter);
+            construct(iter-n,std::move(*iter));
             destroy(iter);
         }
         _end-=n;
@@ -2,6 +2,8 @@
 #include "util.h"
 //#include <algorithm>
 #include "../include/utilities.h"
+#include "../include/execution.h"
+#include "../include/radix_sort.h"
 
 #define CONTAINER_INT VECTOR_INT
 
@@ -42,6 +44,36 @@ int main()
     v1={1,2,3,4,5};v2={5,4,3,2,1};
     swap(v1,v2);PRINT(v1);PRINT(v2);
 
+    //copy copy_backward across deque buffers(4 ints each),overlapping too
+    println("copy");
+    DEQUE_INT de2;
+    for(int i=0;i<20;++i)
+        de2.push_back(i);
+    copy(advance(de2.begin(),3),de2.end(),de2.begin());    //shift left by 3
+    VECTOR_INT v3={3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,17,18,19};
+    PRINT(de2);assert(equal(v3.begin(),v3.end(),de2.begin()));
+    println("copy_backward");
+    for(int i=0;i<20;++i)
+        de2[i]=i;
+    copy_backward(de2.begin(),advance(de2.begin(),15),de2.end());   //shift right by 5
+    v3={0,1,2,3,4,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14};
+    PRINT(de2);assert(equal(v3.begin(),v3.end(),de2.begin()));
+    //between containers
+    v3={100,101,102,103,104,105};
+    assert(copy(v3.begin(),v3.end(),advance(de2.begin(),2))==advance(de2.begin(),8));
+    assert(copy_backward(v3.begin(),v3.end(),advance(de2.begin(),19))==advance(de2.begin(),13));
+    v3.resize(20);
+    assert(copy(de2.begin(),de2.end(),v3.begin())==v3.end());
+    assert(v3[1]==1 && v3[2]==100 && v3[7]==105 && v3[8]==3 && v3[12]==7 && v3[13]==100 && v3[18]==105 && v3[19]==14);
+    //elements that are not trivially copyable
+    deque<string> ds;
+    for(int i=0;i<40;++i)
+        ds.push_back(std::to_string(i));
+    copy_backward(ds.begin(),advance(ds.begin(),30),ds.end());
+    assert(ds[9]=="9" && ds[10]=="0" && ds[25]=="15" && ds[39]=="29");
+    copy(advance(ds.begin(),10),ds.end(),ds.begin());
+    assert(ds[0]=="0" && ds[29]=="29" && ds[30]=="20" && ds[39]=="29");
+
     //adjacent_find
     assert(adjacent_find(v1.begin(),v1.end())==v1.end());
 
@@ -65,6 +97,8 @@ int main()
     //max_element min_element
     assert(*max_element(v1.begin(),v1.end())==5);
     assert(*min_element(v1.begin(),v1.end())==1);
+    auto min_max=minmax_element(v1.begin(),v1.end());
+    assert(*min_max.first==1 && *min_max.second==5);
 
     //merge
     println("\nmerge");
@@ -100,14 +134,65 @@ int main()
     //rotate
     println("rotate");v1={1,2,3,4,5,6,7,8};
     rotate(v1.begin(),advance(v1.begin(),2),v1.end());PRINT(v1);
+    VECTOR_INT rot_want{3,4,5,6,7,8,1,2};
+    assert(equal(v1.begin(),v1.end(),rot_want.begin()));
+    li1={1,2,3,4,5,6,7,8};
+    rotate(li1.begin(),advance(li1.begin(),2),li1.end());
+    PRINT(li1);assert(equal(li1.begin(),li1.end(),rot_want.begin()));
+    DEQUE_INT de3;
+    for(int i=1;i<=8;++i)
+        de3.push_back(i);
+    rotate(de3.begin(),advance(de3.begin(),2),de3.end());
+    PRINT(de3);assert(equal(de3.begin(),de3.end(),rot_want.begin()));
+    //deque iterators move gcd(12,8)=4 cycles
+    de3.clear();
+    for(int i=0;i<12;++i)
+        de3.push_back(i);
+    rotate(de3.begin(),advance(de3.begin(),8),de3.end());
+    for(int i=0;i<12;++i)
+        assert(de3[i]==(i+8)%12);
+    //trivial elements through pointers:halves too big for the buffer are block-swapped
+    v1.clear();
+    for(int i=0;i<300;++i)
+        v1.push_back(i);
+    rotate(v1.begin(),advance(v1.begin(),100),v1.end());
+    for(int i=0;i<300;++i)
+        assert(v1[i]==(i+100)%300);
+    //first==middle and middle==last leave the range alone
+    v1={1,2,3};li1={1,2,3};
+    rotate(v1.begin(),v1.begin(),v1.end());
+    rotate(v1.begin(),v1.end(),v1.end());
+    rotate(li1.begin(),li1.begin(),li1.end());
+    rotate(li1.begin(),li1.end(),li1.end());
+    rotate(de3.begin(),de3.begin(),de3.end());
+    rotate(de3.begin(),de3.end(),de3.end());
+    assert(v1[0]==1 && v1[2]==3 && li1.front()==1 && li1.back()==3);
+    assert(de3.front()==8 && de3.back()==7);
 
     //search
     v1={3,4,3,4,5,6,5},v2={3,4,5};
     assert(search(v1.begin(),v1.end(),v2.begin(),v2.end())==advance(v1.begin(),2));
 
+    //search with a prebuilt searcher
+    const char text[]="abracadabra";
+    const char pattern[]="cad";
+    horspool_searcher<const char*> horspool(pattern,pattern+3);
+    assert(search(text,text+11,horspool)==text+4);
+    two_way_searcher<VECTOR_INT::iterator> two_way(v2.begin(),v2.end());
+    assert(search(v1.begin(),v1.end(),two_way)==advance(v1.begin(),2));
+    assert(search(v2.begin(),v2.end(),two_way)==v2.begin());
+
     //search_n
     assert(search_n(v1.begin(),v1.end(),3,3,[](const int& a,const int& b){return a>b;})==advance(v1.begin(),3));
 
+    //find_end
+    v1={1,2,3,1,2,1,2,3,4},v2={1,2};
+    assert(find_end(v1.begin(),v1.end(),v2.begin(),v2.end())==advance(v1.begin(),5));
+    li1={1,2,3,1,2,1,2,3,4};
+    LIST_INT li2{1,2,3};
+    assert(find_end(li1.begin(),li1.end(),li2.begin(),li2.end())==advance(li1.begin(),5));
+    assert(find_end(v1.begin(),v1.end(),li2.begin(),li2.begin())==v1.end());
+
     //unique
     println("unique");v1={1,1,2,3,3,3,4,5,5,6,7};
     for_each(v1.begin(),unique(v1.begin(),v1.end()),print_single<int>());
@@ -129,6 +214,24 @@ int main()
     assert(!binary_search(v1.begin(),v1.end(),6));
     assert(!binary_search(v1.begin(),v1.end(),9));
 
+    //the same searches on a range sorted by a comparator
+    println("sort with greater");
+    v1={3,8,1,7,3,4,1,2};
+    sort(v1.begin(),v1.end(),greater<int>());PRINT(v1);     //8 7 4 3 3 2 1 1
+    assert(lower_bound(v1.begin(),v1.end(),3,greater<int>())==advance(v1.begin(),3));
+    assert(upper_bound(v1.begin(),v1.end(),3,greater<int>())==advance(v1.begin(),5));
+    assert(lower_bound(v1.begin(),v1.end(),5,greater<int>())==advance(v1.begin(),2));
+    assert(lower_bound(v1.begin(),v1.end(),0,greater<int>())==v1.end());
+    assert(equal_range(v1.begin(),v1.end(),1,greater<int>()).first==advance(v1.begin(),6));
+    assert(binary_search(v1.begin(),v1.end(),7,greater<int>()) && !binary_search(v1.begin(),v1.end(),5,greater<int>()));
+    //by a key,with a lambda
+    vector<pair<string,int>> people{{"bob",31},{"amy",25},{"cat",40},{"dan",25}};
+    auto by_age=[](const pair<string,int>& a,const pair<string,int>& b){return a.second<b.second;};
+    stable_sort(people.begin(),people.end(),by_age);
+    assert(people[0].first=="amy" && people[1].first=="dan" && people[3].first=="cat");
+    assert(lower_bound(people.begin(),people.end(),pair<string,int>("",31),by_age)->first=="bob");
+    assert(max_element(people.begin(),people.end(),by_age)->first=="cat");
+
     //next_permutation prev_permutation
     println("next_permutation");v1={2,1,3,5,4};
     next_permutation(v1.begin(),v1.end());PRINT(v1);
@@ -146,6 +249,64 @@ int main()
     println("partial_sort");v1={1,3,7,6,3,4,2};
     partial_sort(v1.begin(),advance(v1.begin(),4),v1.end());PRINT(v1);
 
+    //stable_sort inplace_merge
+    println("stable_sort");v1={5,2,9,1,5,6,3};
+    stable_sort(v1.begin(),v1.end());PRINT(v1);
+    println("inplace_merge");v1={1,4,7,9,2,3,8};
+    inplace_merge(v1.begin(),advance(v1.begin(),4),v1.end());PRINT(v1);
+
+    //execution policies:par cuts large ranges into chunks for the thread pool
+    println("execution::seq");v1={5,2,9,1,5,6,3};
+    sort(execution::seq,v1.begin(),v1.end());PRINT(v1);
+    VECTOR_INT big(100000);
+    for_each(execution::par,big.begin(),big.end(),[](int& a){a=1;});
+    transform(execution::par,big.begin(),big.end(),big.begin(),[](const int& a){return a*3;});
+    assert(count_if(execution::par,big.begin(),big.end(),[](const int& a){return a==3;})==100000);
+    assert(accumulate(execution::par,big.begin(),big.end(),0)==300000);
+    big[70000]=-1;big[90000]=-2;
+    assert(find_if(execution::par,big.begin(),big.end(),[](const int& a){return a<0;})==advance(big.begin(),70000));
+
+    //thread pool:fork/join on the shared work-stealing pool
+    thread_pool& pool=thread_pool::instance();
+    assert(pool.size()>=1);
+    int left=0,right=0,third=0;
+    pool.parallel_invoke([&]{left=1;},[&]{right=2;});
+    parallel_invoke([&]{left+=10;},[&]{right+=20;},[&]{third=3;});
+    assert(left==11 && right==22 && third==3);
+    parallel_for(size_t(0),big.size(),[&](size_t i){big[i]=int(i%7);});
+    assert(big[0]==0 && big[100]==2 && big[99999]==99999%7);
+
+    //parallel_sort parallel_stable_sort
+    for(size_t i=0;i<big.size();++i)
+        big[i]=int(i*7919%1000);
+    parallel_sort(big.begin(),big.end());
+    for(size_t i=1;i<big.size();++i)
+        assert(big[i-1]<=big[i]);
+    vector<pair<int,int>> recs(big.size());     //{key,original position}
+    for(size_t i=0;i<recs.size();++i)
+        recs[i]=pair<int,int>(int(i*7919%100),int(i));
+    parallel_stable_sort(recs.begin(),recs.end(),[](const pair<int,int>& a,const pair<int,int>& b){return a.first<b.first;});
+    for(size_t i=1;i<recs.size();++i)
+        assert(recs[i-1].first<recs[i].first || (recs[i-1].first==recs[i].first && recs[i-1].second<recs[i].second));
+
+    //radix_sort
+    println("radix_sort");v1={170,-45,75,-90,802,24,2,66};
+    radix_sort(v1.begin(),v1.end());PRINT(v1);
+    //by key and stable:equal keys keep their order
+    for(size_t i=0;i<recs.size();++i)
+        recs[i]=pair<int,int>(int(i*31%257)-128,int(i));
+    radix_sort(recs.begin(),recs.end(),[](const pair<int,int>& r){return r.first;});
+    assert(recs.begin()->first==-128 && (recs.end()-1)->first==128);
+    for(size_t i=1;i<recs.size();++i)
+        assert(recs[i-1].first<recs[i].first || (recs[i-1].first==recs[i].first && recs[i-1].second<recs[i].second));
+    vector<string> words(1000);
+    for(size_t i=0;i<words.size();++i)
+        words[i]=std::to_string(i*7919%1000);
+    radix_sort(words.begin(),words.end());
+    assert(words[0]=="0" && words[1]=="1" && words[2]=="10" && words[999]=="999");
+    for(size_t i=1;i<words.size();++i)
+        assert(words[i-1]<words[i]);
+
     //algorithms for set
     set<int> s1{2,3,4,1,7,8};
     set<int> s2{1,5,6,8,9,4};
@@ -3,6 +3,21 @@
 #include "../include/tree.h"
 #include "../include/set.h"
 #include "../include/map.h"
+#include "../include/btree_set.h"
+#include "../include/btree_map.h"
+#include "../include/flat_set.h"
+#include "../include/flat_map.h"
+#include "../include/flat_hash_set.h"
+#include "../include/flat_hash_map.h"
+#include "../include/hash_map.h"
+#include "../include/persistent_map.h"
+#include "../include/skip_list_map.h"
+#include "../include/concurrent_map.h"
+#include "../include/interval_tree.h"
+#include "../include/range_sum_map.h"
+#include "../include/parallel_tree.h"
+
+#include <thread>
 
 #define IS_SET 0
 #define IS_MAP 1
@@ -31,6 +46,31 @@ struct print_rb_tree_node
     }
 };
 
+//counts the keys built from a const char*,to see which lookup overload runs
+struct tracked_key
+{
+    static int conversions;
+    string s;
+
+    tracked_key(const char* p):s(p){++conversions;}
+};
+int tracked_key::conversions=0;
+
+bool operator<(const tracked_key& a,const tracked_key& b) {return a.s<b.s;}
+bool operator<(const tracked_key& a,const char* b) {return a.s<b;}
+bool operator<(const char* a,const tracked_key& b) {return a<b.s;}
+
+//counts every value built,default or copied
+struct tracked_value
+{
+    static int made;
+    int v;
+
+    tracked_value():v(0){++made;}
+    tracked_value(const tracked_value& x):v(x.v){++made;}
+};
+int tracked_value::made=0;
+
 
 int main()
 {
@@ -165,6 +205,307 @@ int main()
 
 #endif
 
+    //btree_set btree_map
+    println("\nbtree_set :");
+    btree_set<int> bs{5,1,4,1,3};
+    bs.insert(2);PRINT(bs);
+    assert(bs.size()==5 && *bs.begin()==1);
+    assert(bs.find(4)!=bs.end() && bs.find(6)==bs.end());
+    bs.erase(4);
+    assert(!bs.count(4) && *bs.lower_bound(4)==5);
+
+    println("\nbtree_map :");
+    btree_map<string,int> bm{{"b",2},{"a",1}};
+    bm["c"]=3;bm["a"]=10;
+    bm.insert({"d",4});PRINT(bm);
+    assert(bm.size()==4 && bm["a"]==10 && bm.find("c")->second==3);
+    assert(!bm.insert({"d",5}).second && bm["d"]==4);
+    bm.erase("b");
+    assert(bm.find("b")==bm.end() && advance(bm.begin(),1)->first=="c");
+
+    //enough keys to split and merge the nodes
+    btree_map<int,int> bm2;
+    for(int i=0;i<10000;++i)
+        bm2[i*7919%10000]=i;
+    for(int i=0;i<10000;i+=2)
+        bm2.erase(i);
+    assert(bm2.size()==5000 && bm2.begin()->first==1 && bm2.rbegin()->first==9999);
+    assert(bm2.find(4)==bm2.end() && bm2.lower_bound(4)->first==5);
+
+    //flat_set flat_map
+    println("\nflat_set :");
+    flat_set<int> fs{5,1,4,1,3};
+    fs.insert(2);PRINT(fs);
+    assert(fs.size()==5 && *fs.begin()==1 && fs.lower_bound(3)==fs.begin()+2);
+    fs.erase(4);
+    assert(!fs.count(4) && *fs.find(5)==5 && fs.find(6)==fs.end());
+
+    println("\nflat_map :");
+    flat_map<string,int> fm;
+    vector<pair<string,int>> batch{{"d",4},{"b",2},{"e",5},{"a",1}};
+    fm.insert(batch.begin(),batch.end());   //one sort,one merge
+    fm["c"]=3;fm["a"]=10;
+    fm.erase("e");
+    for(auto kv:fm)     //the iterator gives a pair of references
+        printc(kv.first,":",kv.second," ");
+    println();
+    assert(fm.size()==4 && fm["a"]==10 && fm.find("c")->second==3);
+    assert(!fm.insert({"d",5}).second && fm["d"]==4);
+    assert(fm.find("e")==fm.end() && fm.lower_bound("bb")->first=="c");
+
+    //flat_hash_set flat_hash_map(no order)
+    println("\nflat_hash_set :");
+    flat_hash_set<int> hs{5,1,4,1,3};
+    hs.insert(2);PRINT(hs);
+    assert(hs.size()==5 && hs.count(4) && hs.find(6)==hs.end());
+    hs.erase(4);
+    assert(!hs.count(4) && *hs.find(5)==5);
+
+    println("\nflat_hash_map :");
+    flat_hash_map<string,int> hm{{"b",2},{"a",1}};
+    hm["c"]=3;hm["a"]+=10;
+    hm.insert({"d",4});PRINT(hm);
+    assert(hm.size()==4 && hm["a"]==11 && hm.find("c")->second==3);
+    assert(!hm.insert({"d",5}).second && hm["d"]==4);
+    hm.erase("b");
+    int hm_sum=0;
+    for(auto& kv:hm)
+        hm_sum+=kv.second;
+    assert(hm.find("b")==hm.end() && hm_sum==18);
+
+    //enough keys to rehash,and erases that leave deleted slots behind
+    flat_hash_map<int,int> hm2;
+    for(int i=0;i<10000;++i)
+        hm2[i]=i;
+    for(int i=0;i<10000;i+=2)
+        hm2.erase(i);
+    assert(hm2.size()==5000 && hm2.find(4)==hm2.end() && hm2.find(5)->second==5);
+
+    //hash_map:incremental rehash,lookups see both tables meanwhile
+    println("\nhash_map :");
+    hash_map<int,int> chm;
+    for(int i=0;i<5000;++i){
+        chm[i]=i*2;
+        assert(chm.find(i/2)->second==i/2*2);   //older keys,some still in the old table
+    }
+    for(int i=0;i<5000;i+=2)
+        chm.erase(i);
+    assert(chm.size()==2500 && chm.find(4)==chm.end() && chm[4999]==9998 && chm.count(3)==1);
+    //operator[] builds the value in place,and nothing at all for a present key
+    hash_map<string,tracked_value> thm;
+    tracked_value::made=0;
+    thm["a"].v=1;
+    assert(tracked_value::made==1);
+    thm["a"].v+=1;
+    assert(tracked_value::made==1 && thm["a"].v==2 && thm.size()==1);
+
+    //persistent_map
+    println("\npersistent_map :");
+    persistent_map<string,int> pm{{"b",2},{"a",1},{"c",3}};
+    persistent_map<string,int> snap=pm.snapshot();
+    assert(pm.same_version(snap));
+    pm.insert({"d",4});
+    pm.erase("a");
+    pm.insert_or_assign("b",20);
+    PRINT(pm);PRINT(snap);
+    assert(!pm.same_version(snap));
+    assert(pm.size()==3 && pm.find("a")==pm.end() && pm.find("b")->second==20 && pm.begin()->first=="b");
+    //the snapshot still sees the map as it was
+    assert(snap.size()==3 && snap.find("a")->second==1 && snap.find("b")->second==2);
+    assert(snap.find("d")==snap.end() && snap.begin()->first=="a");
+    assert(!pm.insert({"c",30}).second && pm.find("c")->second==3);
+
+    //skip_list_map:writers insert and erase while readers find
+    println("\nskip_list_map :");
+    skip_list_map<int,string> sm;
+    for(int i=0;i<1000;++i)
+        sm.insert({i,std::to_string(i)});
+    std::thread sm_threads[4];
+    int sm_bad[4]={0};
+    for(int t=0;t<4;++t)
+        sm_threads[t]=std::thread([&sm,&sm_bad,t]{
+            for(int round=0;round<20;++round)
+                for(int i=t;i<1000;i+=4){
+                    if(t<2){
+                        sm.erase(i);
+                        sm.insert({i,std::to_string(i)});
+                    }else{
+                        epoch_guard guard;          //keeps the node alive while iter is used
+                        auto iter=sm.find(i^2);     //a key a writer is working on
+                        if(iter!=sm.end() && iter->second!=std::to_string(iter->first))
+                            ++sm_bad[t];
+                        sm_bad[t]+=sm.count(i)!=1;  //readers' own keys are never erased
+                    }
+                }
+        });
+    for(auto& th:sm_threads)
+        th.join();
+    assert(sm_bad[2]==0 && sm_bad[3]==0);
+    assert(sm.size()==1000 && sm.find(500)->second=="500" && sm.contains(999));
+
+    //concurrent_map:writers insert and erase keys 0,1 mod 4,readers look up the rest
+    println("\nconcurrent_map :");
+    concurrent_map<int,int,4> cm;
+    for(int i=0;i<1000;++i)
+        cm.insert({i,i*2});
+    std::thread cm_threads[4];
+    int cm_bad[4]={0};
+    for(int t=0;t<4;++t)
+        cm_threads[t]=std::thread([&cm,&cm_bad,t]{
+            int v;
+            for(int round=0;round<20;++round)
+                for(int i=t;i<1000;i+=4){
+                    if(t<2){
+                        cm.erase(i);
+                        cm.insert({i,i*2});
+                        cm.insert_or_assign(i,i*2);
+                    }else{
+                        cm_bad[t]+=!cm.find(i,v) || v!=i*2;
+                        auto r=cm.try_find(i,v);
+                        cm_bad[t]+=r==decltype(cm)::not_found || (r==decltype(cm)::found && v!=i*2);
+                        if(cm.find(i^2,v) && v!=(i^2)*2)
+                            ++cm_bad[t];
+                    }
+                }
+        });
+    for(auto& th:cm_threads)
+        th.join();
+    assert(cm_bad[2]==0 && cm_bad[3]==0 && cm.size()==1000);
+    //with no writer about,readers racing each other never see busy
+    for(int t=0;t<4;++t)
+        cm_threads[t]=std::thread([&cm,&cm_bad,t]{
+            int v;
+            for(int i=0;i<20000;++i)
+                cm_bad[t]+=cm.try_find(i%1000,v)!=decltype(cm)::found || v!=i%1000*2;
+        });
+    for(auto& th:cm_threads)
+        th.join();
+    assert(!cm_bad[0] && !cm_bad[1] && !cm_bad[2] && !cm_bad[3]);
+
+    //interval_tree
+    println("\ninterval_tree :");
+    interval_tree<int> it{{15,20},{10,30},{17,19},{5,20},{12,15},{30,40}};
+    it.insert(25,26);
+    it.erase(10,30);
+    vector<pair<int,int>> hits;
+    it.overlaps(14,16,back_inserter(hits));
+    for(auto& iv:hits)
+        printc("[",iv.first,",",iv.second,"] ");
+    println();
+    assert(hits.size()==3 && hits[0].first==5 && hits[1].first==12 && hits[2].first==15);
+    hits.clear();
+    it.stab(20,back_inserter(hits));
+    assert(hits.size()==2 && hits[0].first==5 && hits[1].first==15);
+    hits.clear();
+    it.stab(27,back_inserter(hits));
+    assert(hits.empty() && it.find_overlap(27,29)==it.end());
+    assert(it.find_overlap(26,30)!=it.end() && !it.erase(10,30));
+
+    //against a brute-force scan after many inserts and erases
+    interval_tree<int> it2;
+    vector<pair<int,int>> all;
+    for(int i=0;i<500;++i){
+        int low=i*7919%1000,len=i*31%50;
+        it2.insert(low,low+len);
+        all.push_back({low,low+len});
+    }
+    for(int i=0;i<500;i+=3)
+        it2.erase(all[i].first,all[i].second);
+    for(int x=0;x<1050;x+=13){
+        hits.clear();
+        it2.overlaps(x,x+20,back_inserter(hits));
+        size_t n=0;
+        for(int i=0;i<500;++i)
+            n+=i%3 && all[i].first<=x+20 && x<=all[i].second;
+        assert(hits.size()==n);
+    }
+
+    //range_sum_map
+    println("\nrange_sum_map :");
+    range_sum_map<int,int> rs{{1,10},{3,30},{5,50},{7,70}};
+    rs.add(3,3);rs.assign(9,90);rs.insert({4,40});
+    rs.erase(5);
+    PRINT(rs);
+    assert(rs.sum()==243 && rs.prefix_sum(4)==43 && rs.prefix_sum(1)==0);
+    assert(rs.range_sum(3,8)==143 && rs.range_sum(5,7)==0 && rs.range_sum(0,100)==243);
+    range_sum_map<int,long> rs2;
+    for(int i=0;i<1000;++i)
+        rs2.insert({i,i});
+    for(int i=0;i<1000;i+=2)
+        rs2.erase(i);
+    assert(rs2.sum()==250000 && rs2.range_sum(10,20)==75 && rs2.prefix_sum(1000)==250000);
+
+    //parallel_for_each parallel_reduce(parallel_tree.h),big enough to be split
+    println("\nparallel traversal :");
+    set<int> ps;
+    map<int,long> pmap;
+    for(int i=0;i<100000;++i){
+        ps.insert(i*7919%100000);
+        pmap[i]=i;
+    }
+    std::atomic<long> visited(0);
+    ps.parallel_for_each([&visited](const int& v){visited+=v;},4);
+    assert(visited==4999950000L);
+    pmap.parallel_for_each([](pair<int,long>& kv){kv.second*=2;},4);     //non-const map:f may modify
+    const map<int,long>& cpmap=pmap;
+    visited=0;
+    cpmap.parallel_for_each([&visited](const pair<int,long>& kv){visited+=kv.second;},4);
+    assert(visited==2*4999950000L && pmap[99999]==199998);
+    //op need not be commutative:pieces are combined in element order
+    long first=ps.parallel_reduce(-1L,[](long a,long b){return a<0 ? b : a;},[](const int& v){return long(v);},4);
+    long sum=pmap.parallel_reduce(0L,plus<long>(),[](const pair<int,long>& kv){return kv.second;},4);
+    printc("first:",first," sum:",sum);println();
+    assert(first==0 && sum==2*4999950000L);
+
+    //order statistics:nth rank distance
+    println("\norder statistics :");
+    set<int,less<int>,malloc_alloc,rb_tree_order_statistics_update> os;
+    multimap<int,int,less<int>,malloc_alloc,rb_tree_order_statistics_update> omm;
+    for(int i=0;i<2000;++i){
+        os.insert(i*7919%2000*3);               //multiples of 3 in scrambled order
+        omm.insert({i%100,i});
+        if(i%3==2){
+            os.erase((i-1)*7919%2000*3);        //erase as we go
+            omm.erase(omm.find(i%100));
+        }
+    }
+    assert(os.size()==2000-666 && omm.size()==2000-666);
+    size_t pos=0;
+    for(auto iter=os.begin();iter!=os.end();++iter,++pos){
+        assert(*os.nth(pos)==*iter);
+        assert(os.rank(*iter)==pos && *os.nth(os.rank(*iter))==*iter);
+        assert(os.rank(*iter+1)==pos+1);        //a missing key counts the keys below it
+    }
+    assert(os.nth(os.size())==os.end() && os.nth(size_t(-1))==os.end());
+    assert(os.rank(-1)==0 && os.rank(6000)==os.size());
+    assert(os.distance(os.begin(),os.end())==ptrdiff_t(os.size()));
+    //equal keys:rank is the first of them
+    pos=0;
+    for(auto iter=omm.begin();iter!=omm.end();++iter,++pos){
+        assert(omm.nth(pos)==iter);
+        assert(omm.nth(omm.rank(iter->first))->first==iter->first);
+        assert(omm.rank(iter->first)==size_t(omm.distance(omm.begin(),omm.lower_bound(iter->first))));
+    }
+    printc("omm.nth(5):",omm.nth(5)->first,",",omm.nth(5)->second);println();
+
+    //transparent comparator:less<> looks up a const char* without building a string
+    println("\ntransparent lookup :");
+    set<string,less<>> ts{"apple","banana","cherry"};
+    map<string,int,less<>> tm{{"apple",1},{"banana",2}};
+    const char* key="banana";
+    assert(*ts.find(key)=="banana" && ts.count("cherry")==1 && ts.find("durian")==ts.end());
+    assert(*ts.lower_bound("b")=="banana" && *ts.upper_bound("banana")=="cherry");
+    assert(ts.equal_range("apple").first==ts.begin());
+    assert(tm.find(key)->second==2 && tm.count("cherry")==0);
+    //with the default less<Key> the key_type overloads are used:one conversion per call
+    set<tracked_key> plain{"a","b","c"};
+    set<tracked_key,less<>> hetero{"a","b","c"};
+    tracked_key::conversions=0;
+    assert(plain.find("b")!=plain.end() && plain.count("z")==0);
+    assert(tracked_key::conversions==2);
+    assert(hetero.find("b")!=hetero.end() && hetero.count("z")==0 && hetero.lower_bound("b")->s=="b");
+    assert(tracked_key::conversions==2);
+
     return 0;
 }
 
@@ -1,4 +1,4 @@
-#include "utility.h"
+#include "util.h"
 
 #include "../include/queue.h"
 #include "../include/tree.h"
@@ -6,9 +6,58 @@
 using namespace sstl;
 
 
+//orders tasks by priority,then by id(smaller first)
+struct task_order
+{
+    bool operator()(const pair<int,int>& a,const pair<int,int>& b) const
+    {
+        return a.first<b.first || (a.first==b.first && a.second>b.second);
+    }
+};
+
+
 int main()
 {
     priority_queue<int> pq{1,2,3,4,5};
+    pq.push(9);pq.push(0);
+    assert(pq.size()==7 && pq.top()==9);
+    pq.pop();
+    assert(pq.top()==5);
+
+    //min-heap:greater puts the smallest on top
+    println("min-heap");
+    priority_queue<int,vector<int>,greater<int>> minq{5,1,4,1,3};
+    minq.push(2);minq.push(0);
+    while(!minq.empty()){
+        printc(minq.top()," ");
+        int top=minq.top();
+        minq.pop();
+        assert(minq.empty() || top<=minq.top());
+    }
+    println();
+
+    //a comparator object
+    priority_queue<pair<int,int>,vector<pair<int,int>>,task_order> tasks{{1,0},{3,1},{3,2},{2,3}};
+    assert(tasks.top().first==3 && tasks.top().second==1);
+    tasks.pop();
+    assert(tasks.top().first==3 && tasks.top().second==2);
+    tasks.pop();tasks.pop();
+    assert(tasks.top().first==1 && tasks.size()==1);
+
+    //heap algorithms with the same comparator
+    vector<int> v{5,1,4,1,3,9,2,6};
+    make_heap(v.begin(),v.end(),greater<int>());
+    assert(v.front()==1);
+    v.push_back(0);
+    push_heap(v.begin(),v.end(),greater<int>());
+    assert(v.front()==0);
+    pop_heap(v.begin(),v.end(),greater<int>());
+    assert(v.back()==0 && v.front()==1);
+    v.pop_back();
+    sort_heap(v.begin(),v.end(),greater<int>());
+    PRINT(v);
+    vector<int> want{9,6,5,4,3,2,1,1};
+    assert(equal(v.begin(),v.end(),want.begin()));
 
     return 0;
 }
@@ -117,6 +117,18 @@ int main()
 #endif
 
 
+    //copies leave their source as it was
+    println("\ncopy strings :");
+    vector<string> words{"one","two","three"};
+    vector<string> words2(words.begin(),words.end());
+    vector<string> words3(words);
+    deque<string> words4(words.begin(),words.end());
+    PRINT(words);PRINT(words2);PRINT(words3);PRINT(words4);
+    assert(words.size()==3 && words[0]=="one" && words[1]=="two" && words[2]=="three");
+    assert(sstl::equal(words.begin(),words.end(),words2.begin()));
+    assert(sstl::equal(words.begin(),words.end(),words3.begin()));
+    assert(sstl::equal(words.begin(),words.end(),words4.begin()));
+
     println("\nclear");
     con1.clear();
     assert(con1.empty());